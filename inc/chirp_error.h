@@ -64,6 +64,12 @@ public:
         /** @brief Thread-related error */
         THREAD_ERROR,
         
+        /** @brief Downstream has not granted credit for another item */
+        NO_CREDIT,
+        
+        /** @brief The service is shedding load and refused the message */
+        SERVICE_OVERLOADED,
+        
         /** @brief Unknown or unspecified error */
         UNKNOWN_ERROR
     };
@@ -91,6 +97,8 @@ public:
             case INVALID_CONFIGURATION:      return "INVALID_CONFIGURATION";
             case RESOURCE_ALLOCATION_FAILED: return "RESOURCE_ALLOCATION_FAILED";
             case THREAD_ERROR:               return "THREAD_ERROR";
+            case NO_CREDIT:                  return "NO_CREDIT";
+            case SERVICE_OVERLOADED:         return "SERVICE_OVERLOADED";
             case UNKNOWN_ERROR:              return "UNKNOWN_ERROR";
             default:                         return "UNKNOWN_ERROR";
         }
@@ -11,6 +11,7 @@
  */
 
 #pragma once
+#include <array>
 #include <functional>
 #include <map>
 #include <any>
@@ -19,7 +20,10 @@
 #include <iostream>
 #include <sstream>
 #include <utility>
+#include <tuple>
 #include <type_traits>
+#include <chrono>
+#include <cstdint>
 #include "chirp_error.h"
 
 
@@ -28,6 +32,58 @@
 // this one public header file.
 class ChirpImpl;
 class IChirpTimer;   
+class ChirpSimulation;
+class PipelineStage;
+
+/**
+ * @brief Point-in-time counters of a service's message loop
+ */
+struct ChirpServiceStats {
+    uint64_t wakeups = 0;       ///< Times the loop woke up to look for work; every poll() call in polled mode
+    uint64_t timerBatches = 0;  ///< Wakeups that fired at least one timer
+    uint64_t timersFired = 0;   ///< Timer handlers dispatched
+    uint64_t messagesExpired = 0; ///< Messages discarded because their expiry passed while queued
+    uint64_t deadlineMessages = 0; ///< Dispatched messages that carried a deadline
+    uint64_t deadlineMisses = 0;   ///< Of those, messages whose handler finished after the deadline
+    uint64_t messagesShed = 0;     ///< Posts refused or messages dropped while shedding load
+    uint64_t activations = 0;      ///< Times a RunMode::LAZY service was given a loop thread
+};
+
+/**
+ * @brief Queue depth and a histogram of how long messages waited in the queue
+ *
+ * The sojourn time of a message is the time between it joining the run queue
+ * and the loop taking it out. Bucket 0 counts waits under 1ns, bucket i waits
+ * in [2^(i-1), 2^i) ns; the last bucket also holds everything longer. The
+ * counters only grow, so two snapshots give the histogram of the interval
+ * between them.
+ */
+struct ChirpQueueStats {
+    static constexpr size_t SojournBuckets = 40;
+
+    std::array<uint64_t, SojournBuckets> sojourn{};  ///< Messages per sojourn bucket
+    uint64_t dequeued = 0;   ///< Messages taken out of the queue, the sum of all buckets
+    size_t queueDepth = 0;   ///< Messages waiting at the time of the snapshot
+
+    /**
+     * @brief Estimate a sojourn time percentile
+     * @param fraction Percentile as a fraction, e.g. 0.99
+     * @param since Earlier snapshot of the same service, or nullptr for all time
+     * @return Upper edge of the bucket holding the percentile, 0 if nothing was dequeued
+     */
+    std::chrono::nanoseconds sojournPercentile(double fraction, const ChirpQueueStats* since = nullptr) const;
+};
+
+/**
+ * @brief A handler that ran longer than the service's slow handler threshold
+ */
+struct ChirpSlowHandler {
+    static constexpr size_t LogCapacity = 32;   ///< Entries kept per service; the oldest is dropped first
+
+    std::string message;                          ///< Message name, or timer message name
+    std::chrono::steady_clock::time_point started;
+    std::chrono::nanoseconds duration{0};
+};
 
 /**
  * @brief Main service class for Chirp framework
@@ -50,6 +106,54 @@ class IChirpTimer;
  */
 class IChirp {
 public:
+    /**
+     * @brief Execution model of a service
+     */
+    enum class RunMode {
+        THREADED,   /**< The service spins its message loop on a dedicated thread */
+        POLLED,     /**< No thread is spawned; the owner drives the loop with poll() or runFor() */
+        LAZY        /**< Like THREADED, but the thread is only spawned once there is work; see setIdleTimeout() */
+    };
+
+    /**
+     * @brief Order in which queued messages are dispatched
+     */
+    enum class SchedulingPolicy {
+        FIFO,                    /**< Posting order (default) */
+        EARLIEST_DEADLINE_FIRST  /**< Earliest deadline first, posting order on ties */
+    };
+
+    /**
+     * @brief How an overloaded service sheds load
+     */
+    enum class SheddingPolicy {
+        NONE,        /**< Accept and dispatch every message (default) */
+        DROP_STALE,  /**< Discard async messages that waited longer than the target sojourn time */
+        REJECT_NEW   /**< Refuse new posts with SERVICE_OVERLOADED; queued messages still run */
+    };
+
+    /**
+     * @brief Message delivered, with the expired message's name, instead of a message whose expiry passed
+     *
+     * Register a handler taking (std::string msgName) under this name to be told about
+     * discarded messages. Without one, expired messages are dropped silently.
+     */
+    static constexpr const char* ExpiredMessage = "ChirpMsgExpired";
+
+    /**
+     * @brief Readiness flags for file descriptor handlers
+     *
+     * FD_READABLE and FD_WRITABLE select what to wait for when registering.
+     * The handler receives the subset that is ready, plus FD_ERROR or
+     * FD_HANGUP when the descriptor reports them.
+     */
+    enum FdEvent : uint32_t {
+        FD_READABLE = 1u << 0,  /**< Data can be read without blocking */
+        FD_WRITABLE = 1u << 1,  /**< Data can be written without blocking */
+        FD_ERROR    = 1u << 2,  /**< An error is pending on the descriptor (reported only) */
+        FD_HANGUP   = 1u << 3   /**< The peer closed its end (reported only) */
+    };
+
     /**
      * @brief Default constructor
      * @note This constructor is provided for backward compatibility but should not be used
@@ -83,10 +187,174 @@ public:
      * processing messages once started.
      * 
      * @return ChirpError::SUCCESS if the service started successfully,
-     *         ChirpError::INVALID_SERVICE_STATE if the service is not properly initialized
+     *         ChirpError::INVALID_SERVICE_STATE if the service is not properly initialized,
+     *         ChirpError::SERVICE_ALREADY_STARTED if the service is already running
      */
     ChirpError::Error start();
 
+    /**
+     * @brief Start the service in the given run mode
+     * @param mode RunMode::THREADED behaves like start(). RunMode::POLLED spawns no
+     *             thread; messages and timers are dispatched by poll() or runFor()
+     *             on the caller's thread. RunMode::LAZY accepts posts right away
+     *             but spawns the loop thread only when the first message,
+     *             delayed message or timer is added.
+     * @return ChirpError::SUCCESS if the service started successfully,
+     *         ChirpError::INVALID_SERVICE_STATE if the service is not properly initialized,
+     *         ChirpError::SERVICE_ALREADY_STARTED if the service is already running
+     *
+     * @note A polled service must always be driven from the same thread, and that
+     *       thread must not issue syncMsg() to the service it polls.
+     */
+    ChirpError::Error start(RunMode mode);
+
+    /**
+     * @brief Dispatch pending work of a polled service inline
+     * @param budget Maximum number of messages to dispatch in this call. Timers
+     *               that are due are always fired.
+     * @param dispatched Optional output for the number of handlers executed
+     * @return ChirpError::SUCCESS on success,
+     *         ChirpError::INVALID_SERVICE_STATE if the service was not started with RunMode::POLLED
+     *
+     * Never blocks. If work is left over after the budget is exhausted the poll
+     * descriptor stays readable.
+     */
+    ChirpError::Error poll(size_t budget, size_t* dispatched = nullptr);
+
+    /**
+     * @brief Drive a polled service for a fixed amount of time
+     * @param duration How long to keep dispatching messages and timers
+     * @param dispatched Optional output for the number of handlers executed
+     * @return ChirpError::SUCCESS on success,
+     *         ChirpError::INVALID_SERVICE_STATE if the service was not started with RunMode::POLLED
+     *
+     * Blocks the caller, sleeping while there is no work, until the duration has
+     * elapsed or the service is shut down.
+     */
+    ChirpError::Error runFor(const std::chrono::milliseconds& duration, size_t* dispatched = nullptr);
+
+    /**
+     * @brief Get a descriptor that becomes readable when the service has work
+     * @return A pollable file descriptor, or -1 if the service is not initialized
+     *
+     * The descriptor is level triggered and can be added to an existing epoll or
+     * poll set. It is readable while messages are queued or a timer is due; call
+     * poll() when it is. The descriptor is owned by the service and must not be closed.
+     */
+    int getPollFd() const;
+
+    /**
+     * @brief Read the service's loop counters
+     * @param stats Output parameter for the counters
+     * @return ChirpError::Error indicating success or failure
+     *
+     * timersFired / timerBatches is the average number of timers that shared
+     * a wakeup, which rises as timers are given slack.
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error getServiceStats(ChirpServiceStats& stats) const;
+
+    /**
+     * @brief Read the service's queue depth and sojourn time histogram
+     * @param stats Output parameter for the snapshot
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error getQueueStats(ChirpQueueStats& stats) const;
+
+    /**
+     * @brief Read how many messages expired in the queue, per message name
+     * @param counts Output map, replaced with one entry per name that has expired
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const;
+
+    /**
+     * @brief Log every handler that runs longer than a threshold
+     * @param threshold Handler run time above which it is logged, zero to stop logging
+     * @return ChirpError::Error indicating success or failure
+     *
+     * While a threshold is set the loop reads the clock once more after each
+     * handler. Only the last ChirpSlowHandler::LogCapacity entries are kept.
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold);
+
+    /**
+     * @brief Read the slow handler log
+     * @param log Output vector, replaced with the logged handlers, oldest first
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error getSlowHandlers(std::vector<ChirpSlowHandler>& log) const;
+
+    /**
+     * @brief Select the order in which queued messages are dispatched
+     * @param policy SchedulingPolicy::FIFO or SchedulingPolicy::EARLIEST_DEADLINE_FIRST
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Under EARLIEST_DEADLINE_FIRST the queue is a min-heap on deadline, so
+     * posting and dispatching cost O(log n). Messages posted with
+     * postMsgWithDeadline() are ordered by their deadline. Any other message is
+     * given the time it was posted as its deadline, so it cannot be starved by
+     * work whose deadline lies further ahead. Messages already queued are
+     * reordered when the policy changes.
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error setSchedulingPolicy(SchedulingPolicy policy);
+
+    /**
+     * @brief Get the current scheduling policy
+     * @return The policy set by setSchedulingPolicy(), FIFO by default
+     */
+    SchedulingPolicy getSchedulingPolicy() const;
+
+    /**
+     * @brief Start or stop shedding load
+     * @param policy SheddingPolicy to apply, NONE to stop shedding
+     * @param maxSojourn Target sojourn time, required by DROP_STALE
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Under DROP_STALE a message that waited in the queue longer than
+     * maxSojourn is discarded when dequeued, without running its handler, so
+     * the messages that do run stay close to the target. Sync messages are
+     * never dropped. Under REJECT_NEW postMsg() and its variants and syncMsg()
+     * return SERVICE_OVERLOADED. Both are counted in ChirpServiceStats::messagesShed.
+     *
+     * Usually applied and lifted by a watchdog, see IChirpWatchDog::setLoadShedding().
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error setLoadShedding(SheddingPolicy policy,
+                                      const std::chrono::nanoseconds& maxSojourn = std::chrono::nanoseconds(0));
+
+    /**
+     * @brief Get the shedding policy in force
+     * @return The policy set by setLoadShedding(), NONE by default
+     */
+    SheddingPolicy getLoadShedding() const;
+
+    /**
+     * @brief Let an idle RunMode::LAZY service give its thread back
+     * @param timeout How long the loop must have had nothing to do; 0 (the default) keeps the thread
+     * @return ChirpError::SUCCESS on success,
+     *         ChirpError::INVALID_ARGUMENTS if the timeout is negative
+     *
+     * Once the queue has been empty for the timeout and no timer, delayed
+     * message or descriptor watch is registered, the loop thread exits. The
+     * next message or timer spawns a new one. Ignored by other run modes.
+     *
+     * @note This method is thread-safe
+     */
+    ChirpError::Error setIdleTimeout(const std::chrono::milliseconds& timeout);
+
     /**
      * @brief Shutdown the service
      * 
@@ -189,6 +457,54 @@ public:
         return ChirpError::SUCCESS;
     }
 
+    /**
+     * @brief Register a handler for readiness of a file descriptor
+     * @tparam Obj Type of the object
+     * @tparam Ret Return type of the handler method
+     * @param fd The descriptor to watch (socket, pipe, eventfd, ...)
+     * @param events Combination of FD_READABLE and FD_WRITABLE to wait for
+     * @param object Pointer to the object instance
+     * @param method Pointer to the member method, called with the descriptor and
+     *               the FdEvent bits that are ready
+     * @return ChirpError::SUCCESS if registration succeeds,
+     *         ChirpError::HANDLER_ALREADY_EXISTS if the descriptor is already watched,
+     *         ChirpError::INVALID_ARGUMENTS if the descriptor cannot be watched
+     *
+     * The service waits on the descriptor together with its queue and timers and
+     * runs the handler on the service thread, in sequence with message handlers.
+     * Readiness is level triggered: the handler is called again on the next loop
+     * iteration if it leaves data unread.
+     *
+     * @note The descriptor remains owned by the caller. Unregister it before closing it.
+     * @note This method is thread-safe
+     */
+    template<typename Obj, typename Ret>
+    ChirpError::Error registerFdHandler(int fd,
+                                        uint32_t events,
+                                        Obj* object,
+                                        Ret(Obj::*method)(int, uint32_t)) {
+        if (!_impl) {
+            return ChirpError::INVALID_SERVICE_STATE;
+        }
+        if (!object || !method) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return addFdWatch(fd, events, [object, method](int readyFd, uint32_t ready) {
+            (void)(object->*method)(readyFd, ready);
+        });
+    }
+
+    /**
+     * @brief Stop watching a file descriptor
+     * @param fd The descriptor passed to registerFdHandler()
+     * @return ChirpError::SUCCESS if the watch was removed,
+     *         ChirpError::HANDLER_NOT_FOUND if the descriptor is not watched
+     *
+     * @note This method is thread-safe. A readiness event collected before the
+     *       call returns is discarded, the handler is not invoked for it.
+     */
+    ChirpError::Error unregisterFdHandler(int fd);
+
     /**
      * @brief Add a timer to the service
      * @param timer Pointer to IChirpTimer instance to add
@@ -202,6 +518,51 @@ public:
      */
     ChirpError::Error addChirpTimer(IChirpTimer* timer);
 
+    /**
+     * @brief Add a timer that calls a typed handler directly
+     * @tparam Obj Type of the object
+     * @tparam Ret Return type of the handler method (ignored)
+     * @tparam Args Parameter types of the handler method
+     * @tparam BoundArgs Types of the arguments stored with the timer
+     * @param timer Pointer to a configured IChirpTimer instance to add
+     * @param object Pointer to the object instance
+     * @param method Pointer to the member method called on every firing
+     * @param args Arguments passed to the method on every firing, copied once now
+     * @return ChirpError::Error indicating success or failure
+     *
+     * The handler and its arguments are bound to the timer here, once, and
+     * captured with the timer's mode and period when the service arms it.
+     * Firing then calls the method with the stored arguments: no message is
+     * built, no handler is looked up by name and nothing is allocated. The
+     * timer's message name is only used for logging.
+     *
+     * @example
+     * @code
+     * idleTimer->configure("IdleTimeout", std::chrono::seconds(30), IChirpTimer::TimerMode::ONE_SHOT);
+     * service.addChirpTimer(idleTimer, &server, &Server::closeIdle, connectionId);
+     * @endcode
+     *
+     * @note The binding replaces any earlier one; addChirpTimer(timer) removes it
+     * @note This method is thread-safe
+     */
+    template<typename Obj, typename Ret, typename... Args, typename... BoundArgs>
+    ChirpError::Error addChirpTimer(IChirpTimer* timer,
+                                    Obj* object,
+                                    Ret(Obj::*method)(Args...),
+                                    BoundArgs&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(BoundArgs),
+                      "Timer handler must take exactly the bound arguments");
+        static_assert(std::is_invocable_v<Ret(Obj::*)(Args...), Obj*, std::decay_t<BoundArgs>&...>,
+                      "Bound arguments do not match the timer handler");
+        if (!object || !method) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return addBoundTimer(timer,
+            [object, method, bound = std::make_tuple(std::decay_t<BoundArgs>(std::forward<BoundArgs>(args))...)]() mutable {
+                std::apply([object, method](auto&... stored) { (void)(object->*method)(stored...); }, bound);
+            });
+    }
+
     /**
      * @brief Remove a timer from the service
      * @param timer Pointer to IChirpTimer instance to remove
@@ -210,7 +571,9 @@ public:
      * Removes the provided timer from the service's timer manager. After removal,
      * the timer will no longer fire events through this service.
      * 
-     * @note This method is thread-safe
+     * @note This method is thread-safe. Called off the service thread it waits
+     *       until the service thread has released the timer, so the timer may be
+     *       deleted as soon as it returns.
      * @note The timer instance is not deleted by this method
      */
     ChirpError::Error removeChirpTimer(IChirpTimer* timer);
@@ -221,11 +584,39 @@ public:
      */
     static const std::string& getVersion();
 
+    /**
+     * @brief Wait on timer deadlines from one process-wide thread
+     * @param enable true to start the shared timer thread, false to stop it
+     * @return ChirpError::SUCCESS on success,
+     *         ChirpError::INVALID_SERVICE_STATE if stopping while services still use it,
+     *         ChirpError::RESOURCE_ALLOCATION_FAILED if its descriptors cannot be created
+     *
+     * By default every service arms a timer descriptor of its own at its next
+     * timer deadline. Services started while the shared thread is enabled hand
+     * that deadline to it instead. The shared thread waits for the earliest
+     * deadline of all of them and wakes only the service it belongs to, so
+     * hundreds of mostly idle services cost one timer and one waiting thread.
+     * Timers still fire on their own service's thread.
+     *
+     * @note The setting applies to services started afterwards. A service
+     *       stops using the shared thread when it is shut down.
+     */
+    static ChirpError::Error useSharedTimerThread(bool enable);
+
     // Watchdog monitoring flag
     void setWatchDogMonitoring(bool enabled);
     bool getWatchDogMonitoring() const;
 
 private:
+    // The simulation scheduler inspects timer deadlines of the services it drives
+    friend class ChirpSimulation;
+    // Pipeline stages post their internal wakeups without handler validation
+    friend class PipelineStage;
+    // The watchdog reads the loop heartbeats of the services it monitors
+    friend class ChirpWatchDog;
+    // The factory signals every service to stop before joining any of them
+    friend class ChirpFactory;
+
     static const std::string _version;
     /**
      * @brief Base case for collectArgs when there are no arguments left
@@ -398,6 +789,52 @@ private:
      */
     void getCbMap(std::map<std::string, std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap);
 
+    /**
+     * @brief Install a file descriptor watch on the service loop
+     * @param fd The descriptor to watch
+     * @param events FdEvent bits to wait for
+     * @param callback Invoked on the service thread with the ready bits
+     * @return ChirpError::Error indicating success or failure
+     */
+    ChirpError::Error addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback);
+
+    /**
+     * @brief Internal method behind the typed addChirpTimer() overload
+     * @param timer The timer to add
+     * @param handler Called on the service thread each time the timer fires
+     * @return ChirpError::Error indicating success or failure
+     */
+    ChirpError::Error addBoundTimer(IChirpTimer* timer, std::function<void()> handler);
+
+    /**
+     * @brief Internal method to enqueue an async message that expires or has a deadline
+     * @param msgName The message name
+     * @param args The message arguments
+     * @param expiry Point after which the message is discarded instead of dispatched
+     * @param deadline Point by which the message should have been handled
+     * @return ChirpError::Error indicating success or failure
+     */
+    ChirpError::Error enqueMsg(std::string& msgName, std::vector<std::any>& args,
+                               std::chrono::steady_clock::time_point expiry,
+                               std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Internal method to enqueue an async message that is held back until a due time
+     * @param msgName The message name
+     * @param args The message arguments
+     * @param due Point at which the message joins the queue
+     * @return ChirpError::Error indicating success or failure
+     */
+    ChirpError::Error enqueDeferredMsg(std::string& msgName, std::vector<std::any>& args,
+                                       std::chrono::steady_clock::time_point due);
+
+    /**
+     * @brief Convert a duration from now into a time point on the service clock
+     * @param duration Offset from the current time
+     * @return The time point
+     */
+    static std::chrono::steady_clock::time_point timeAfter(const std::chrono::nanoseconds& duration);
+
     ChirpImpl* _impl; ///< Pointer to the implementation class (PIMPL idiom)
 
     // Callback to capture validation errors for sync messages
@@ -459,9 +896,150 @@ public:
      */
     template<typename T, typename... Args>
     ChirpError::Error postMsg(T first_arg, Args... remaining_args) {
+        return postMsgTimed(PostTiming{}, first_arg, remaining_args...);
+    }
+
+    /**
+     * @brief Post a message that is only worth dispatching for a limited time
+     * @tparam T Type of the first argument (message name)
+     * @tparam Args Variadic template for remaining arguments
+     * @param ttl How long the message may wait in the queue
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Like postMsg(), but if the message is still queued ttl after posting it is
+     * discarded before its handler is looked up. It is then counted in
+     * getExpiredMsgCounts() and reported to the ExpiredMessage handler, if any.
+     *
+     * @note This method is thread-safe and can be called from any thread
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgWithTtl(const std::chrono::nanoseconds& ttl, T first_arg, Args... remaining_args) {
+        return postMsgTimed(PostTiming{.expiry = timeAfter(ttl)}, first_arg, remaining_args...);
+    }
+
+    /**
+     * @brief Post a message that is only worth dispatching until a point in time
+     * @tparam T Type of the first argument (message name)
+     * @tparam Args Variadic template for remaining arguments
+     * @param expiry steady_clock instant after which the message is discarded
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Use this to carry a request's own deadline across services. See postMsgWithTtl().
+     *
+     * @note This method is thread-safe and can be called from any thread
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgWithExpiry(std::chrono::steady_clock::time_point expiry,
+                                        T first_arg, Args... remaining_args) {
+        if (expiry == std::chrono::steady_clock::time_point{}) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return postMsgTimed(PostTiming{.expiry = expiry}, first_arg, remaining_args...);
+    }
+
+    /**
+     * @brief Post a message that should be handled by a point in time
+     * @tparam T Type of the first argument (message name)
+     * @tparam Args Variadic template for remaining arguments
+     * @param deadline steady_clock instant by which the handler should have finished
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Under SchedulingPolicy::EARLIEST_DEADLINE_FIRST the message overtakes
+     * queued work with a later deadline. Under FIFO the deadline only feeds the
+     * deadlineMessages and deadlineMisses counters of getServiceStats(). Unlike an
+     * expiry, a missed deadline never drops the message.
+     *
+     * @note This method is thread-safe and can be called from any thread
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgWithDeadline(std::chrono::steady_clock::time_point deadline,
+                                          T first_arg, Args... remaining_args) {
+        if (deadline == std::chrono::steady_clock::time_point{}) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return postMsgTimed(PostTiming{.deadline = deadline}, first_arg, remaining_args...);
+    }
+
+    /**
+     * @brief Post a message that is dispatched after a delay
+     * @tparam T Type of the first argument (message name)
+     * @tparam Args Variadic template for remaining arguments
+     * @param delay How long to hold the message back
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     *
+     * The message is validated now and kept in the service's timer schedule
+     * until the delay has passed. It then joins the back of the queue like any
+     * posted message. No IChirpTimer is needed, and the message cannot be
+     * cancelled once posted.
+     *
+     * @note This method is thread-safe and can be called from any thread
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgAfter(const std::chrono::nanoseconds& delay, T first_arg, Args... remaining_args) {
+        return postMsgTimed(PostTiming{.due = timeAfter(delay)}, first_arg, remaining_args...);
+    }
+
+    /**
+     * @brief Post a message that is dispatched at a point in time
+     * @tparam T Type of the first argument (message name)
+     * @tparam Args Variadic template for remaining arguments
+     * @param due steady_clock instant at which the message joins the queue
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     *
+     * See postMsgAfter(). A due time in the past queues the message on the
+     * service's next loop iteration.
+     *
+     * @note This method is thread-safe and can be called from any thread
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgAt(std::chrono::steady_clock::time_point due, T first_arg, Args... remaining_args) {
+        if (due == std::chrono::steady_clock::time_point{}) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return postMsgTimed(PostTiming{.due = due}, first_arg, remaining_args...);
+    }
+
+private:
+    // false, counting the refusal, while the service sheds load with REJECT_NEW
+    bool admitPost();
+
+    // Signal the loop to stop without waiting for it; shutdown() completes the stop
+    void requestStop();
+
+    /**
+     * @brief Optional time points of an async post, default constructed when unused
+     */
+    struct PostTiming {
+        std::chrono::steady_clock::time_point due{};      ///< Held back until this point
+        std::chrono::steady_clock::time_point expiry{};   ///< Discarded if still queued after this point
+        std::chrono::steady_clock::time_point deadline{}; ///< Should be handled by this point
+    };
+
+    /**
+     * @brief Validate and enqueue an async message
+     * @param timing Due time, expiry and deadline of the message
+     * @param first_arg The message name (first argument)
+     * @param remaining_args The arguments to pass to the handler
+     * @return ChirpError::Error indicating success or failure
+     */
+    template<typename T, typename... Args>
+    ChirpError::Error postMsgTimed(const PostTiming& timing, T first_arg, Args... remaining_args) {
         if (!_impl) {
             return ChirpError::INVALID_SERVICE_STATE;
         }
+        if (!admitPost()) {
+            return ChirpError::SERVICE_OVERLOADED;
+        }
 
         // Build args and validate without invoking user handler
         std::vector<std::any> args;
@@ -493,9 +1071,18 @@ public:
         }
 
         // Enqueue for execution on the service thread (single execution)
-        return enqueMsg(msgName, args);
+        if (timing.due != std::chrono::steady_clock::time_point{}) {
+            return enqueDeferredMsg(msgName, args, timing.due);
+        }
+        if (timing.expiry == std::chrono::steady_clock::time_point{} &&
+            timing.deadline == std::chrono::steady_clock::time_point{}) {
+            return enqueMsg(msgName, args);
+        }
+        return enqueMsg(msgName, args, timing.expiry, timing.deadline);
     }
 
+public:
+
     /**
      * @brief Synchronously post a message to the service and wait for the result
      * @tparam T Type of the first argument (message name)
@@ -516,6 +1103,9 @@ public:
         if (!_impl) {
             return ChirpError::INVALID_SERVICE_STATE;
         }
+        if (!admitPost()) {
+            return ChirpError::SERVICE_OVERLOADED;
+        }
 
         ChirpError::Error validationError = ChirpError::SUCCESS;
 
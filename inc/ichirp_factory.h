@@ -11,6 +11,7 @@
  */
 
 #pragma once
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,6 +20,49 @@
 // Forward declaration to prevent inclusion of private headers
 class IChirp;
 
+/**
+ * @brief Copyable handle that keeps a factory service alive
+ *
+ * Look a service up once with IChirpFactory::getServiceRef() and post through
+ * the handle from then on. Copying it costs a reference count increment. If
+ * the service is destroyed meanwhile, the handle keeps the object valid and
+ * posts fail with INVALID_SERVICE_STATE instead of touching freed memory.
+ */
+class ChirpServiceRef {
+public:
+    ChirpServiceRef() = default;
+    explicit ChirpServiceRef(std::shared_ptr<IChirp> service) : _service(std::move(service)) {}
+
+    IChirp* get() const { return _service.get(); }
+    IChirp* operator->() const { return _service.get(); }
+    IChirp& operator*() const { return *_service; }
+    explicit operator bool() const { return static_cast<bool>(_service); }
+
+private:
+    std::shared_ptr<IChirp> _service;
+};
+
+/**
+ * @brief Notified as a factory creates and destroys services
+ *
+ * Callbacks run on the thread creating or destroying the service, with the
+ * factory lock held. They must be quick and must not call into the factory.
+ */
+class IChirpFactoryObserver {
+public:
+    virtual ~IChirpFactoryObserver() = default;
+
+    /**
+     * @brief A service was created, or existed when the observer was added
+     */
+    virtual void onServiceCreated(const std::string& service_name, IChirp* service) = 0;
+
+    /**
+     * @brief A service is about to be deleted; service stays valid until this returns
+     */
+    virtual void onServiceDestroyed(const std::string& service_name, IChirp* service) = 0;
+};
+
 /**
  * @brief Abstract factory interface for creating and managing Chirp services
  * 
@@ -28,6 +72,11 @@ class IChirp;
  * 
  * @note Implementations should be thread-safe
  * 
+ * getInstance() returns the process-wide default context. createFactory()
+ * creates further contexts, each with its own registry, lock, observers and
+ * dependencies, so independent subsystems or test shards never contend with
+ * each other or clash on service names.
+ *
  * @example
  * @code
  * IChirpFactory* factory = &ChirpFactory::getInstance();
@@ -37,9 +86,22 @@ class IChirp;
  */
 class IChirpFactory {
 public:
-    // Singleton access via interface
+    // Sent synchronously, without arguments, by startAllServices() to each
+    // service it starts that has registered a handler for it
+    static constexpr const char* StartupMessage = "ChirpStartup";
+
+    // Singleton access via interface: the default context
     static IChirpFactory& getInstance();
 
+    /**
+     * @brief Create an independent factory context
+     * @return The new context, nullptr if allocation failed; the caller deletes it
+     *
+     * Deleting a context shuts down every service it still holds. Pipelines,
+     * simulations and watchdogs that use a context must be destroyed first.
+     */
+    static IChirpFactory* createFactory();
+
     /**
      * @brief Virtual destructor for proper cleanup
      */
@@ -63,6 +125,13 @@ public:
      */
     virtual IChirp* getService(const std::string& service_name) = 0;
 
+    /**
+     * @brief Get a handle to an existing service by name
+     * @param service_name The name of the service to retrieve
+     * @return A handle to the service, empty if it does not exist
+     */
+    virtual ChirpServiceRef getServiceRef(const std::string& service_name) = 0;
+
     /**
      * @brief Destroy a service by name
      * @param service_name The name of the service to destroy
@@ -84,9 +153,84 @@ public:
 
     /**
      * @brief Shutdown all services managed by the factory
+     *
+     * Every service is signalled to stop at once and the services are joined
+     * in parallel, so this takes as long as the slowest service rather than
+     * the sum of all of them. Returns once every service has stopped.
      */
     virtual void shutdownAllServices() = 0;
 
+    /**
+     * @brief Shutdown all services managed by the factory within one deadline
+     * @param timeout Overall time allowed for every service to stop
+     * @param missed Output list of services that had not stopped by the deadline
+     * @return ChirpError::SUCCESS if every service stopped in time,
+     *         ChirpError::TIMEOUT otherwise
+     *
+     * All services leave the registry immediately. A service that misses the
+     * deadline, typically because a handler is stuck, finishes stopping in the
+     * background and is deleted once it has.
+     */
+    virtual ChirpError::Error shutdownAllServices(const std::chrono::milliseconds& timeout,
+                                                  std::vector<std::string>& missed) = 0;
+
+    /**
+     * @brief Start every service managed by the factory that is not running yet
+     * @param failed Output list of services that could not be started
+     * @return ChirpError::SUCCESS if every service is running,
+     *         otherwise the error of the first service that failed to start
+     *
+     * Services are started in waves ordered by the declared dependencies: a
+     * wave holds every service whose dependencies are all running. The
+     * services of a wave are started together, and each one that registered a
+     * handler for StartupMessage runs it on its own thread. The next wave
+     * starts once every startup handler of the current one has returned.
+     *
+     * Services already started, in either run mode, count as running and get
+     * no StartupMessage. A service whose dependency is not registered or
+     * failed to start is not started and is reported as failed.
+     */
+    virtual ChirpError::Error startAllServices(std::vector<std::string>& failed) = 0;
+
+    /**
+     * @brief Declare that a service must be running before another one starts
+     * @param service_name The dependent service
+     * @param depends_on The service it depends on
+     * @return ChirpError::SUCCESS if declared, or if it already was,
+     *         ChirpError::INVALID_ARGUMENTS if a name is empty or both are the same,
+     *         ChirpError::INVALID_CONFIGURATION if it would create a dependency cycle
+     *
+     * Dependencies are kept by name, so they may be declared before the
+     * services are created and survive their destruction.
+     */
+    virtual ChirpError::Error addDependency(const std::string& service_name, const std::string& depends_on) = 0;
+
+    /**
+     * @brief Remove a dependency declared with addDependency()
+     * @return ChirpError::SUCCESS if removed,
+     *         ChirpError::SERVICE_NOT_FOUND if no such dependency was declared
+     */
+    virtual ChirpError::Error removeDependency(const std::string& service_name, const std::string& depends_on) = 0;
+
+    /**
+     * @brief Start notifying an observer of service creation and destruction
+     * @param observer The observer, which must outlive its registration
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Every existing service is reported to the observer as created before this
+     * returns, atomically with respect to later creations and destructions.
+     */
+    virtual ChirpError::Error addObserver(IChirpFactoryObserver* observer) = 0;
+
+    /**
+     * @brief Stop notifying an observer
+     * @param observer The observer passed to addObserver()
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Once this returns the factory no longer calls the observer
+     */
+    virtual ChirpError::Error removeObserver(IChirpFactoryObserver* observer) = 0;
+
     /**
      * @brief Get the version of the factory implementation
      * @return The version string (e.g., "1.0")
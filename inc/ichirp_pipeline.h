@@ -0,0 +1,133 @@
+/**
+ * @file ichirp_pipeline.h
+ * @brief Declarative pipelines of Chirp services with credit-based flow control
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * A pipeline is a strict chain of services. Each stage owns a bounded
+ * single-producer/single-consumer ring that only its upstream neighbour
+ * writes to. A free slot in that ring is a credit: the producer may only
+ * hand over an item while it holds one, and the consumer grants a credit
+ * back each time it takes an item out. A slow stage therefore stalls its
+ * producers instead of letting queues grow.
+ */
+
+#pragma once
+#include <any>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "chirp_error.h"
+#include "ichirp_factory.h"
+
+/**
+ * @brief Point-in-time counters for one pipeline stage
+ */
+struct PipelineStageStats {
+    std::string name;       ///< Service name of the stage
+    uint64_t processed = 0; ///< Items taken out of the stage's ring
+    uint64_t dropped = 0;   ///< Items whose handler did not return SUCCESS
+    size_t occupancy = 0;   ///< Items waiting in the stage's ring
+    size_t capacity = 0;    ///< Ring size, i.e. the credits granted upstream
+    double itemsPerSecond = 0.0; ///< Processed items per second since start()
+};
+
+/**
+ * @brief Builder and runtime for a chain of services connected by SPSC rings
+ *
+ * Stages are added in order; start() creates one factory service per stage
+ * and starts it. Stage handlers run on their stage's service thread and
+ * receive the item by reference, so they may transform it in place. Returning
+ * SUCCESS forwards the item to the next stage, any other code drops it.
+ *
+ * @example
+ * @code
+ * IChirpPipeline* ingest = IChirpPipeline::createPipeline(&IChirpFactory::getInstance());
+ * ingest->addStage("Decode", &decoder, &Decoder::decode, 256);
+ * ingest->addStage("Enrich", &enricher, &Enricher::enrich, 256);
+ * ingest->addStage("Publish", &publisher, &Publisher::publish, 64);
+ * ingest->start();
+ * if (ingest->push(frame) == ChirpError::NO_CREDIT) {
+ *     // back off, the pipeline is saturated
+ * }
+ * @endcode
+ */
+class IChirpPipeline {
+public:
+    using StageHandler = std::function<ChirpError::Error(std::any& item)>;
+
+    virtual ~IChirpPipeline() = default;
+
+    // Factory: creates a concrete ChirpPipeline and returns it as interface pointer
+    static IChirpPipeline* createPipeline(IChirpFactory* factory);
+
+    /**
+     * @brief Append a stage to the end of the pipeline
+     * @param serviceName Name of the service created for this stage
+     * @param handler Called on the stage's service thread for every item
+     * @param capacity Ring size, i.e. how many items upstream may have in flight
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Stages can only be added before start()
+     */
+    virtual ChirpError::Error addStage(const std::string& serviceName,
+                                       StageHandler handler,
+                                       size_t capacity) = 0;
+
+    /**
+     * @brief Append a stage backed by a member function
+     * @tparam Obj Type of the object
+     * @param serviceName Name of the service created for this stage
+     * @param object Pointer to the object instance
+     * @param method Member function receiving each item
+     * @param capacity Ring size, i.e. how many items upstream may have in flight
+     * @return ChirpError::Error indicating success or failure
+     */
+    template<typename Obj>
+    ChirpError::Error addStage(const std::string& serviceName,
+                               Obj* object,
+                               ChirpError::Error(Obj::*method)(std::any&),
+                               size_t capacity) {
+        if (!object || !method) {
+            return ChirpError::INVALID_ARGUMENTS;
+        }
+        return addStage(serviceName,
+                        StageHandler([object, method](std::any& item) { return (object->*method)(item); }),
+                        capacity);
+    }
+
+    /**
+     * @brief Create and start one factory service per stage
+     * @return ChirpError::Error indicating success or failure
+     */
+    virtual ChirpError::Error start() = 0;
+
+    /**
+     * @brief Shut down and destroy the stage services
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Items still in flight are discarded
+     */
+    virtual ChirpError::Error stop() = 0;
+
+    /**
+     * @brief Hand an item to the first stage
+     * @param item The item to process
+     * @return SUCCESS, or NO_CREDIT if the first stage's ring is full
+     *
+     * @note Must always be called from the same thread, since that thread is
+     *       the single producer of the first stage's ring
+     */
+    virtual ChirpError::Error push(std::any item) = 0;
+
+    /**
+     * @brief Read the counters of every stage, in pipeline order
+     * @param stats Output vector, replaced with one entry per stage
+     * @return ChirpError::Error indicating success or failure
+     */
+    virtual ChirpError::Error getStageStats(std::vector<PipelineStageStats>& stats) const = 0;
+};
@@ -0,0 +1,96 @@
+/**
+ * @file ichirp_simulation.h
+ * @brief Deterministic virtual-time scheduler for Chirp services
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * A simulation switches the framework to virtual time and drives every
+ * service of a factory from the calling thread. Timers fire when virtual
+ * time reaches their deadline, and virtual time jumps straight to the next
+ * deadline once all services are idle. Hours of timer-driven behaviour run
+ * in milliseconds and every run dispatches in the same order.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+#include "chirp_error.h"
+#include "ichirp_factory.h"
+
+// Forward declaration
+class IChirp;
+
+/**
+ * @brief Single-threaded scheduler that runs Chirp services under virtual time
+ *
+ * Services are started in polled mode and polled round-robin, one message per
+ * service per round, in service-name order. Only one simulation may be active
+ * per process because the clock is process-wide.
+ *
+ * @note Synchronous calls between simulated services are not supported, since
+ *       the caller would block the only thread that can answer them
+ *
+ * @example
+ * @code
+ * IChirpSimulation* sim = IChirpSimulation::createSimulation(&IChirpFactory::getInstance());
+ * sim->start();
+ * service->addChirpTimer(timer);
+ * sim->runFor(std::chrono::hours(2));   // returns almost immediately
+ * sim->stop();
+ * delete sim;
+ * @endcode
+ */
+class IChirpSimulation {
+public:
+    virtual ~IChirpSimulation() = default;
+
+    // Factory: creates a concrete ChirpSimulation and returns it as interface pointer
+    static IChirpSimulation* createSimulation(IChirpFactory* factory);
+
+    /**
+     * @brief Switch to virtual time and start all factory services in polled mode
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Fails with INVALID_SERVICE_STATE if a factory service is already
+     *       running on its own thread
+     */
+    virtual ChirpError::Error start() = 0;
+
+    /**
+     * @brief Switch back to the system clock
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Services stay in polled mode; shut them down as usual
+     */
+    virtual ChirpError::Error stop() = 0;
+
+    /**
+     * @brief Drive a service that is not owned by the factory
+     * @param service The service to add, e.g. a watchdog's own service
+     * @return ChirpError::Error indicating success or failure
+     */
+    virtual ChirpError::Error attach(IChirp* service) = 0;
+
+    /**
+     * @brief Dispatch queued messages and due timers until no service has work
+     * @return Number of handlers dispatched
+     *
+     * Virtual time does not move.
+     */
+    virtual size_t runUntilIdle() = 0;
+
+    /**
+     * @brief Advance virtual time, firing every timer that falls due on the way
+     * @param duration Amount of virtual time to simulate
+     * @return Number of handlers dispatched
+     */
+    virtual size_t runFor(const std::chrono::nanoseconds& duration) = 0;
+
+    /**
+     * @brief Virtual time elapsed since start()
+     * @return Elapsed virtual time
+     */
+    virtual std::chrono::nanoseconds elapsed() const = 0;
+};
@@ -12,10 +12,22 @@
 
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include "chirp_error.h"
 
+/**
+ * @brief How late a timer's handler was dispatched relative to its firing time
+ */
+struct TimerLatenessStats {
+    uint64_t samples = 0;                   ///< Number of firings recorded
+    std::chrono::nanoseconds min{0};        ///< Smallest lateness
+    std::chrono::nanoseconds avg{0};        ///< Mean lateness
+    std::chrono::nanoseconds p99{0};        ///< 99th percentile, within 12.5% (1/8) above the true value
+    std::chrono::nanoseconds max{0};        ///< Largest lateness
+};
+
 /**
  * @brief Abstract timer interface for the Chirp framework
  * 
@@ -35,6 +47,23 @@
  */
 class IChirpTimer {
 public:
+    /**
+     * @brief How a timer behaves after it fires
+     */
+    enum class TimerMode {
+        PERIODIC,   /**< Re-armed one duration after each firing */
+        ONE_SHOT    /**< Fires once, then is released from its service and stops */
+    };
+
+    /**
+     * @brief What a periodic timer does when its service stalled past one or more ticks
+     */
+    enum class MissedTickPolicy {
+        CATCH_UP,   /**< Dispatch every overdue tick, back to back, until caught up */
+        SKIP,       /**< Drop all overdue ticks and resume at the next aligned tick */
+        COALESCE    /**< Dispatch once for all overdue ticks, then resume at the next aligned tick */
+    };
+
     /**
      * @brief Virtual destructor for proper cleanup
      */
@@ -74,6 +103,40 @@ public:
     virtual ChirpError::Error configure(std::string messageToDeliver, 
                                       const std::chrono::milliseconds& duration) = 0; 
 
+    /**
+     * @brief Configure the timer with message, duration and mode
+     * @param messageToDeliver The message to deliver when timer fires
+     * @param duration The interval for periodic timers, or the delay for one-shot
+     *                 timers, with nanosecond resolution
+     * @param mode PERIODIC or ONE_SHOT
+     * @return ChirpError::Error indicating success or failure
+     *
+     * @note Timer must be stopped before reconfiguration
+     *
+     * @example
+     * @code
+     * timer->configure("ControlTick", std::chrono::microseconds(250), IChirpTimer::TimerMode::PERIODIC);
+     * @endcode
+     */
+    virtual ChirpError::Error configure(std::string messageToDeliver,
+                                      const std::chrono::nanoseconds& duration,
+                                      TimerMode mode) = 0;
+
+    /**
+     * @brief Configure a one-shot timer that fires at an absolute time
+     * @param messageToDeliver The message to deliver when timer fires
+     * @param deadline The steady_clock instant at which to fire
+     * @return ChirpError::Error indicating success or failure
+     *
+     * A deadline that has already passed fires on the next loop iteration.
+     * After firing, the timer is released from its service and stops, so it
+     * can be deleted from within its own handler or re-armed.
+     *
+     * @note Timer must be stopped before reconfiguration
+     */
+    virtual ChirpError::Error configureAt(std::string messageToDeliver,
+                                        const std::chrono::steady_clock::time_point& deadline) = 0;
+
 
     /**
      * @brief Start the timer
@@ -108,10 +171,87 @@ public:
      * @brief Get the current timer mode
      * @return The current timer mode
      */
+    virtual TimerMode getMode() const = 0;
+
+    /**
+     * @brief Choose how a periodic timer recovers from a stall
+     * @param policy CATCH_UP (the default), SKIP or COALESCE
+     * @return ChirpError::Error indicating success or failure
+     *
+     * A tick is overdue when the next one is also due by the time it is
+     * dispatched. Ticks stay aligned to the original schedule under every policy.
+     *
+     * @note May be changed while the timer is running
+     */
+    virtual ChirpError::Error setMissedTickPolicy(MissedTickPolicy policy) = 0;
+
+    /**
+     * @brief Get the missed-tick policy
+     * @return The current missed-tick policy
+     */
+    virtual MissedTickPolicy getMissedTickPolicy() const = 0;
+
+    /**
+     * @brief Get the total number of ticks that were never dispatched
+     * @return Ticks dropped by SKIP or folded into another dispatch by COALESCE
+     */
+    virtual uint64_t getMissedTicks() const = 0;
+
+    /**
+     * @brief Get the number of ticks folded into the latest dispatch
+     * @return Extra ticks covered by the current or most recent COALESCE dispatch
+     *
+     * Meant to be read from the timer's handler, so it can scale its work
+     * by the number of periods that actually elapsed.
+     */
+    virtual uint64_t getLastMissedTicks() const = 0;
 
     /**
      * @brief Get the current timer duration
-     * @return The current timer duration in milliseconds
+     * @return The current timer duration truncated to milliseconds, 0 for timers armed with configureAt()
      */
     virtual std::chrono::milliseconds getDuration() const = 0;
+
+    /**
+     * @brief Get the current timer duration at full resolution
+     * @return The current timer duration in nanoseconds, 0 for timers armed with configureAt()
+     */
+    virtual std::chrono::nanoseconds getDurationNs() const = 0;
+
+    /**
+     * @brief Allow the timer to fire later than its firing time
+     * @param slack How late the timer may fire, 0 (the default) for no slack
+     * @return ChirpError::Error indicating success or failure
+     *
+     * A timer with slack may fire anywhere in [firing time, firing time + slack].
+     * The service wakes up once at the end of the earliest such window and
+     * fires every timer whose window has opened by then, so timers with
+     * similar deadlines share a wakeup. Later ticks of a periodic timer stay
+     * aligned to its firing times, not to when it actually fired.
+     *
+     * @note Takes effect from the next time the service schedules the timer
+     */
+    virtual ChirpError::Error setSlack(const std::chrono::nanoseconds& slack) = 0;
+
+    /**
+     * @brief Get the timer's slack
+     * @return How late the timer may fire
+     */
+    virtual std::chrono::nanoseconds getSlack() const = 0;
+
+    /**
+     * @brief Get firing lateness statistics
+     * @param stats Output parameter for the statistics
+     * @return ChirpError::Error indicating success or failure
+     *
+     * Lateness is measured on the service thread, from the timer's scheduled
+     * firing time to the moment its handler is dispatched. It includes any
+     * slack the service used to coalesce wakeups.
+     */
+    virtual ChirpError::Error getLatenessStats(TimerLatenessStats& stats) const = 0;
+
+    /**
+     * @brief Discard all recorded lateness samples
+     */
+    virtual void resetLatenessStats() = 0;
 };
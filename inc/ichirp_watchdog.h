@@ -3,13 +3,18 @@
 #include <string>
 
 #include "ichirp_factory.h"
-
-// Forward declaration
-class IChirp;
+#include "ichirp.h"
 
 class IChirpWatchDog {
 public:
     static constexpr const char* MissedPetMessage = "ChirpMissedPetting";
+    // Posted with the service name when a service still responds but its
+    // queue latency or depth is over the thresholds set for it
+    static constexpr const char* DegradedMessage = "ChirpServiceDegraded";
+    // Posted after MissedPetMessage when the stalled service is inside a
+    // handler, with the service name, the handler's message name and how
+    // long it has been running (std::chrono::nanoseconds)
+    static constexpr const char* StuckHandlerMessage = "ChirpStuckHandler";
 
     explicit IChirpWatchDog(const std::string& name);
     virtual ~IChirpWatchDog() = default;
@@ -21,6 +26,25 @@ public:
                                         const std::chrono::milliseconds& petDuration) = 0;
     virtual ChirpError::Error start() = 0;
     virtual ChirpError::Error stop() = 0;
+
+    // Judge a service degraded when, over one monitor period, the p99 time its
+    // messages waited in the queue exceeds p99Sojourn, or when more than
+    // maxQueueDepth messages are waiting. A zero threshold is not checked.
+    // Returns INVALID_CONFIGURATION for a depth-only threshold on a service
+    // set to shed with DROP_STALE.
+    virtual ChirpError::Error setHealthThresholds(const std::string& serviceName,
+                                                  const std::chrono::nanoseconds& p99Sojourn,
+                                                  size_t maxQueueDepth) = 0;
+
+    // Shed load automatically: when a service is judged degraded, apply policy
+    // to it (see IChirp::setLoadShedding(); DROP_STALE targets the p99Sojourn
+    // threshold, so it needs one: INVALID_CONFIGURATION is returned if the
+    // service's thresholds have none). Shedding is lifted once the service has
+    // stayed under half of each threshold for RecoveryTicks monitor periods
+    // in a row, or when the watchdog stops. NONE turns automatic shedding off.
+    static constexpr unsigned RecoveryTicks = 2;
+    virtual ChirpError::Error setLoadShedding(const std::string& serviceName,
+                                              IChirp::SheddingPolicy policy) = 0;
     
     // Getter for the internal Chirp service
     virtual IChirp* getChirpService() = 0;
@@ -7,6 +7,8 @@ thread_local bool IChirp::_validateOnly = false;
 #include "chirp_logger.h"
 #include "chirp_impl.h"
 #include "chirp_timer.h"
+#include "chirp_clock.h"
+#include "shared_timer_thread.h"
 
 // A simple reflection pattern implemented to abstract IChirp class.
 // Cannot implement a typical interface pattern because templated functions 
@@ -17,8 +19,19 @@ const std::string& IChirp::getVersion() {
     return _version;
 }
 
+ChirpError::Error IChirp::useSharedTimerThread(bool enable) {
+    SharedTimerThread& sharedTimers = SharedTimerThread::instance();
+    if (sharedTimers.setEnabled(enable)) {
+        return ChirpError::SUCCESS;
+    }
+    return enable ? ChirpError::RESOURCE_ALLOCATION_FAILED : ChirpError::INVALID_SERVICE_STATE;
+}
+
 void IChirp::setWatchDogMonitoring(bool enabled) {
     _watchdogMonitoringEnabled = enabled;
+    if (_impl) {
+        _impl->setWatchDogMonitoring(enabled);
+    }
 }
 
 bool IChirp::getWatchDogMonitoring() const {
@@ -40,13 +53,171 @@ IChirp::~IChirp() {
 }
 
 ChirpError::Error IChirp::start() {
+    return start(RunMode::THREADED);
+}
+
+ChirpError::Error IChirp::start(RunMode mode) {
     if (!_impl) {
         return ChirpError::INVALID_SERVICE_STATE; // Cannot start if not properly initialized
     }
-    _impl->start();
+    switch (mode) {
+        case RunMode::POLLED:
+            return _impl->startPolled();
+        case RunMode::LAZY:
+            return _impl->startLazy();
+        default:
+            return _impl->start();
+    }
+}
+
+ChirpError::Error IChirp::poll(size_t budget, size_t* dispatched) {
+    size_t count = 0;
+    ChirpError::Error result = ChirpError::INVALID_SERVICE_STATE;
+    if (_impl) {
+        result = _impl->poll(budget, count);
+    }
+    if (dispatched) {
+        *dispatched = count;
+    }
+    return result;
+}
+
+ChirpError::Error IChirp::runFor(const std::chrono::milliseconds& duration, size_t* dispatched) {
+    size_t count = 0;
+    ChirpError::Error result = ChirpError::INVALID_SERVICE_STATE;
+    if (_impl) {
+        result = _impl->runFor(duration, count);
+    }
+    if (dispatched) {
+        *dispatched = count;
+    }
+    return result;
+}
+
+int IChirp::getPollFd() const {
+    if (!_impl) {
+        return -1;
+    }
+    return _impl->getPollFd();
+}
+
+ChirpError::Error IChirp::getServiceStats(ChirpServiceStats& stats) const {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    _impl->getServiceStats(stats);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::getQueueStats(ChirpQueueStats& stats) const {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    _impl->getQueueStats(stats);
+    return ChirpError::SUCCESS;
+}
+
+std::chrono::nanoseconds ChirpQueueStats::sojournPercentile(double fraction, const ChirpQueueStats* since) const {
+    std::array<uint64_t, SojournBuckets> counts = sojourn;
+    uint64_t total = 0;
+    for (size_t i = 0; i < SojournBuckets; ++i) {
+        if (since) {
+            counts[i] -= since->sojourn[i];
+        }
+        total += counts[i];
+    }
+    if (total == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    // Rank of the percentile sample, counted from 1
+    uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total));
+    rank = std::min(std::max<uint64_t>(rank, 1), total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < SojournBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::chrono::nanoseconds(i == 0 ? 1 : (int64_t{1} << i));
+        }
+    }
+    return std::chrono::nanoseconds(int64_t{1} << (SojournBuckets - 1));
+}
+
+ChirpError::Error IChirp::getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    _impl->getExpiredMsgCounts(counts);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    if (threshold.count() < 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    _impl->setSlowHandlerThreshold(threshold);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::getSlowHandlers(std::vector<ChirpSlowHandler>& log) const {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    _impl->getSlowHandlers(log);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::setSchedulingPolicy(SchedulingPolicy policy) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    _impl->setSchedulingPolicy(policy);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::setLoadShedding(SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    if (maxSojourn.count() < 0 || (policy == SheddingPolicy::DROP_STALE && maxSojourn.count() == 0)) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    _impl->setLoadShedding(policy, maxSojourn);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error IChirp::setIdleTimeout(const std::chrono::milliseconds& timeout) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    if (timeout.count() < 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    _impl->setIdleTimeout(timeout);
     return ChirpError::SUCCESS;
 }
 
+IChirp::SheddingPolicy IChirp::getLoadShedding() const {
+    if (!_impl) {
+        return SheddingPolicy::NONE;
+    }
+    return _impl->getLoadShedding();
+}
+
+bool IChirp::admitPost() {
+    return _impl->admitPost();
+}
+
+IChirp::SchedulingPolicy IChirp::getSchedulingPolicy() const {
+    if (!_impl) {
+        return SchedulingPolicy::FIFO;
+    }
+    return _impl->getSchedulingPolicy();
+}
+
 ChirpError::Error IChirp::shutdown() {
     if (!_impl) {
         return ChirpError::INVALID_SERVICE_STATE; // Cannot shutdown if not properly initialized
@@ -55,6 +226,12 @@ ChirpError::Error IChirp::shutdown() {
     return ChirpError::SUCCESS;
 }
 
+void IChirp::requestStop() {
+    if (_impl) {
+        _impl->requestStop();
+    }
+}
+
 std::string IChirp::getServiceName() {
     if (!_impl) {
         return ""; // Return empty string if not properly initialized
@@ -69,6 +246,27 @@ ChirpError::Error IChirp::enqueMsg(std::string& msgName, std::vector<std::any>&
     return _impl->enqueMsg(msgName, args);
 }
 
+ChirpError::Error IChirp::enqueMsg(std::string& msgName, std::vector<std::any>& args,
+                                   std::chrono::steady_clock::time_point expiry,
+                                   std::chrono::steady_clock::time_point deadline) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    return _impl->enqueMsg(msgName, args, expiry, deadline);
+}
+
+ChirpError::Error IChirp::enqueDeferredMsg(std::string& msgName, std::vector<std::any>& args,
+                                           std::chrono::steady_clock::time_point due) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    return _impl->enqueDeferredMsg(msgName, args, due);
+}
+
+std::chrono::steady_clock::time_point IChirp::timeAfter(const std::chrono::nanoseconds& duration) {
+    return ChirpClock::now() + duration;
+}
+
 ChirpError::Error IChirp::enqueSyncMsg(std::string& msgName, std::vector<std::any>& args) {
     if (!_impl) {
         return ChirpError::INVALID_SERVICE_STATE;
@@ -84,6 +282,20 @@ void IChirp::getCbMap(std::map<std::string, std::function<ChirpError::Error(std:
     _impl->getCbMap(funcMap);
 }
 
+ChirpError::Error IChirp::addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    return _impl->addFdWatch(fd, events, std::move(callback));
+}
+
+ChirpError::Error IChirp::unregisterFdHandler(int fd) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    return _impl->removeFdWatch(fd);
+}
+
 ChirpError::Error IChirp::addChirpTimer(IChirpTimer* timer) {
     ChirpError::Error result = ChirpError::SUCCESS;
     
@@ -98,6 +310,8 @@ ChirpError::Error IChirp::addChirpTimer(IChirpTimer* timer) {
             ChirpLogger::instance(getServiceName()) << "Failed to cast IChirpTimer to ChirpTimer" << std::endl;
             result = ChirpError::INVALID_ARGUMENTS;
         } else {
+            // Plain timers dispatch by message name
+            chirpTimer->bindHandler(nullptr);
             _impl->addChirpTimer(chirpTimer);
             result = ChirpError::SUCCESS;
         }
@@ -106,6 +320,21 @@ ChirpError::Error IChirp::addChirpTimer(IChirpTimer* timer) {
     return result;
 }
 
+ChirpError::Error IChirp::addBoundTimer(IChirpTimer* timer, std::function<void()> handler) {
+    if (!_impl) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    ChirpTimer* chirpTimer = dynamic_cast<ChirpTimer*>(timer);
+    if (!chirpTimer || !handler) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    // Allocated once here, so firing only takes a reference
+    chirpTimer->bindHandler(std::make_shared<ChirpTimer::BoundHandler>(std::move(handler)));
+    _impl->addChirpTimer(chirpTimer);
+    return ChirpError::SUCCESS;
+}
+
 ChirpError::Error IChirp::removeChirpTimer(IChirpTimer* timer) {
     ChirpError::Error result = ChirpError::SUCCESS;
     
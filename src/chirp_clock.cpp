@@ -0,0 +1,46 @@
+/**
+ * @file chirp_clock.cpp
+ * @brief Implementation of the ChirpClock time source
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#include "chirp_clock.h"
+
+std::atomic<bool> ChirpClock::_virtual{false};
+std::atomic<int64_t> ChirpClock::_virtualNs{0};
+
+ChirpClock::time_point ChirpClock::now() {
+
+    if (_virtual.load(std::memory_order_acquire)) {
+        return time_point(std::chrono::nanoseconds(_virtualNs.load(std::memory_order_acquire)));
+    }
+    return std::chrono::steady_clock::now();
+}
+
+bool ChirpClock::isVirtual() {
+
+    return _virtual.load(std::memory_order_acquire);
+}
+
+void ChirpClock::useVirtualTime(time_point start) {
+
+    _virtualNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count(),
+                     std::memory_order_release);
+    _virtual.store(true, std::memory_order_release);
+}
+
+void ChirpClock::advanceTo(time_point t) {
+
+    int64_t target = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    int64_t current = _virtualNs.load(std::memory_order_acquire);
+    while (target > current &&
+           !_virtualNs.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+    }
+}
+
+void ChirpClock::useSystemTime() {
+
+    _virtual.store(false, std::memory_order_release);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file chirp_clock.h
+ * @brief Pluggable time source for the Chirp framework
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * All timer bookkeeping reads time through ChirpClock instead of calling
+ * std::chrono::steady_clock directly. By default the clock forwards to
+ * steady_clock. A simulation can switch it to virtual time, which only moves
+ * when it is explicitly advanced.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Process-wide clock used by timers, the message loop and the watchdog
+ */
+class ChirpClock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief Current time of the active time source
+     * @return steady_clock::now(), or the virtual time while virtual time is in use
+     */
+    static time_point now();
+
+    /**
+     * @brief Check whether virtual time is in use
+     * @return true if time only moves through advanceTo()
+     */
+    static bool isVirtual();
+
+    /**
+     * @brief Switch to virtual time, frozen at the given instant
+     * @param start The initial virtual time
+     */
+    static void useVirtualTime(time_point start);
+
+    /**
+     * @brief Move virtual time forward
+     * @param t The new virtual time. Ignored if it is earlier than the current one.
+     */
+    static void advanceTo(time_point t);
+
+    /**
+     * @brief Switch back to steady_clock
+     */
+    static void useSystemTime();
+
+private:
+    static std::atomic<bool> _virtual;
+    static std::atomic<int64_t> _virtualNs;
+};
@@ -9,17 +9,22 @@
 
 #pragma once
 #include "ichirp_factory.h"
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <mutex>
+#include <set>
+#include <unordered_map>
 
 /*
  * Concrete implementation of the ChirpFactory interface
  * 
- * ChirpFactory provides a singleton implementation of the IChirpFactory interface.
+ * ChirpFactory provides the IChirpFactory interface. The default context is a
+ * singleton; further contexts come from IChirpFactory::createFactory().
  * It ensures centralized control over service creation and can manage service
  * lifecycle, configuration, and resource allocation.
  * 
- * This class is thread-safe and follows the singleton pattern
+ * This class is thread-safe
  */
 class ChirpFactory : public IChirpFactory {
 public:
@@ -29,22 +34,56 @@ public:
     // Implementation of IChirpFactory interface
     ChirpError::Error createService(const std::string& service_name, IChirp** service) override;
     IChirp* getService(const std::string& service_name) override;
+    ChirpServiceRef getServiceRef(const std::string& service_name) override;
     bool destroyService(const std::string& service_name) override;
     size_t getServiceCount() const override;
     std::vector<std::string> listServiceNames() const override;
     void shutdownAllServices() override;
+    ChirpError::Error shutdownAllServices(const std::chrono::milliseconds& timeout,
+                                          std::vector<std::string>& missed) override;
+    ChirpError::Error startAllServices(std::vector<std::string>& failed) override;
+    ChirpError::Error addDependency(const std::string& service_name, const std::string& depends_on) override;
+    ChirpError::Error removeDependency(const std::string& service_name, const std::string& depends_on) override;
+    ChirpError::Error addObserver(IChirpFactoryObserver* observer) override;
+    ChirpError::Error removeObserver(IChirpFactoryObserver* observer) override;
     const std::string& getVersion() const override;
 
+    // A context shuts its services down when destroyed; the default
+    // context leaves them to static destruction
+    explicit ChirpFactory(bool context = true);
+    ~ChirpFactory() override;
+
 private:
  
-    ChirpFactory() = default;
-    ~ChirpFactory() = default;
     ChirpFactory(const ChirpFactory&) = delete;
     ChirpFactory& operator=(const ChirpFactory&) = delete;
     ChirpFactory(ChirpFactory&&) = delete;
     ChirpFactory& operator=(ChirpFactory&&) = delete;
 
     static const std::string _version;
+    // Immutable copy of _services for lookups. Readers never lock: each thread
+    // caches the snapshot it last used and reloads it only when
+    // _snapshotVersion shows a newer one was published.
+    struct ServiceEntry {
+        IChirp* service;
+        std::weak_ptr<IChirp> owner;
+    };
+    using ServiceSnapshot = std::unordered_map<std::string, ServiceEntry>;
+    const ServiceSnapshot& snapshot() const;
+    void publishLocked();
+    ChirpError::Error stopAll(std::chrono::steady_clock::time_point deadline,
+                              std::vector<std::string>& missed);
+    // Starts a wave of services and runs their startup handlers; one result per service
+    std::vector<ChirpError::Error> startWave(const std::vector<std::pair<std::string, std::shared_ptr<IChirp>>>& wave);
+
+    std::atomic<std::shared_ptr<const ServiceSnapshot>> _snapshot;
+    std::atomic<uint64_t> _snapshotVersion{0};
+
+    // Authoritative registry, changed only under _mutex
     std::map<std::string, std::shared_ptr<IChirp>> _services;
+    std::vector<IChirpFactoryObserver*> _observers;
+    // Service name -> names of the services it depends on
+    std::map<std::string, std::set<std::string>> _dependencies;
     mutable std::mutex _mutex;
+    const bool _context;
 }; 
\ No newline at end of file
@@ -6,6 +6,13 @@
  * @version 2.0
  */
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <new>
+#include <system_error>
+#include <thread>
+
 #include "chirp_factory.h"
 #include "ichirp_factory.h"
 #include "ichirp.h"
@@ -19,9 +26,26 @@ IChirpFactory& IChirpFactory::getInstance() {
     return ChirpFactory::getInstance();
 }
 
+// Static factory that hides concrete type from callers
+IChirpFactory* IChirpFactory::createFactory() {
+    return new (std::nothrow) ChirpFactory();
+}
+
+ChirpFactory::ChirpFactory(bool context)
+    : _context(context) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    publishLocked();
+}
+
+ChirpFactory::~ChirpFactory() {
+    if (_context) {
+        shutdownAllServices();
+    }
+}
+
 // Concrete singleton accessor
 ChirpFactory& ChirpFactory::getInstance() {
-    static ChirpFactory instance;
+    static ChirpFactory instance(false);
     return instance;
 }
 
@@ -54,24 +78,76 @@ ChirpError::Error ChirpFactory::createService(const std::string& service_name, I
     
     // Store the service in our map
     _services[service_name] = std::shared_ptr<IChirp>(newService);
+    publishLocked();
     
     // Set the output parameter to point to the created service
     *service = newService;
+    for (auto* observer : _observers) {
+        observer->onServiceCreated(service_name, newService);
+    }
     
     ChirpLogger::instance("ChirpFactory") << "Created service '" << service_name << "'" << std::endl;
     return ChirpError::SUCCESS;
 }
 
 IChirp* ChirpFactory::getService(const std::string& service_name) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    auto it = _services.find(service_name);
-    if (it != _services.end()) {
-        return it->second.get();
+    const ServiceSnapshot& services = snapshot();
+    auto it = services.find(service_name);
+    return it != services.end() ? it->second.service : nullptr;
+}
+
+ChirpServiceRef ChirpFactory::getServiceRef(const std::string& service_name) {
+    const ServiceSnapshot& services = snapshot();
+    auto it = services.find(service_name);
+    return it != services.end() ? ChirpServiceRef(it->second.owner.lock()) : ChirpServiceRef();
+}
+
+const ChirpFactory::ServiceSnapshot& ChirpFactory::snapshot() const {
+    // A few entries so a thread switching between contexts keeps hitting.
+    // Versions are unique across contexts, so an entry left by a destroyed
+    // context at the same address never matches.
+    struct Cache {
+        const ChirpFactory* factory = nullptr;
+        uint64_t version = 0;
+        std::shared_ptr<const ServiceSnapshot> services;
+    };
+    static constexpr size_t CacheEntries = 4;
+    thread_local std::array<Cache, CacheEntries> caches;
+    thread_local size_t nextVictim = 0;
+
+    Cache* cache = nullptr;
+    for (auto& entry : caches) {
+        if (entry.factory == this) {
+            cache = &entry;
+            break;
+        }
     }
-    
-    ChirpLogger::instance("ChirpFactory") << "Service '" << service_name << "' not found" << std::endl;
-    return nullptr;
+    if (!cache) {
+        cache = &caches[nextVictim];
+        nextVictim = (nextVictim + 1) % CacheEntries;
+        cache->factory = this;
+        cache->version = 0;
+    }
+
+    uint64_t version = _snapshotVersion.load(std::memory_order_acquire);
+    if (cache->version != version) {
+        // At least as new as version; a newer one is simply reloaded next time
+        cache->services = _snapshot.load(std::memory_order_acquire);
+        cache->version = version;
+    }
+    return *cache->services;
+}
+
+void ChirpFactory::publishLocked() {
+    static std::atomic<uint64_t> nextVersion{1};
+
+    auto services = std::make_shared<ServiceSnapshot>();
+    services->reserve(_services.size());
+    for (const auto& [name, service] : _services) {
+        services->emplace(name, ServiceEntry{service.get(), service});
+    }
+    _snapshot.store(std::move(services), std::memory_order_release);
+    _snapshotVersion.store(nextVersion.fetch_add(1), std::memory_order_release);
 }
 
 bool ChirpFactory::destroyService(const std::string& service_name) {
@@ -81,7 +157,11 @@ bool ChirpFactory::destroyService(const std::string& service_name) {
     if (it != _services.end()) {
         // Shutdown the service before removing it
         it->second->shutdown();
+        for (auto* observer : _observers) {
+            observer->onServiceDestroyed(it->first, it->second.get());
+        }
         _services.erase(it);
+        publishLocked();
         ChirpLogger::instance("ChirpFactory") << "Destroyed service '" << service_name << "'" << std::endl;
         return true;
     }
@@ -91,8 +171,7 @@ bool ChirpFactory::destroyService(const std::string& service_name) {
 }
 
 size_t ChirpFactory::getServiceCount() const {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _services.size();
+    return snapshot().size();
 }
 
 std::vector<std::string> ChirpFactory::listServiceNames() const {
@@ -106,17 +185,295 @@ std::vector<std::string> ChirpFactory::listServiceNames() const {
 }
 
 void ChirpFactory::shutdownAllServices() {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    ChirpLogger::instance("ChirpFactory") << "Shutting down " << _services.size() << " services" << std::endl;
-    
-    for (auto& pair : _services) {
-        ChirpLogger::instance("ChirpFactory") << "Shutting down service '" << pair.first << "'" << std::endl;
-        pair.second->shutdown();
+    std::vector<std::string> missed;
+    (void)stopAll(std::chrono::steady_clock::time_point::max(), missed);
+}
+
+ChirpError::Error ChirpFactory::shutdownAllServices(const std::chrono::milliseconds& timeout,
+                                                    std::vector<std::string>& missed) {
+    missed.clear();
+    if (timeout.count() < 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    // Service threads run in real time, so the deadline ignores ChirpClock
+    return stopAll(std::chrono::steady_clock::now() + timeout, missed);
+}
+
+ChirpError::Error ChirpFactory::stopAll(std::chrono::steady_clock::time_point deadline,
+                                        std::vector<std::string>& missed) {
+    std::map<std::string, std::shared_ptr<IChirp>> services;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ChirpLogger::instance("ChirpFactory") << "Shutting down " << _services.size() << " services" << std::endl;
+
+        // Signal every loop before joining any so they all wind down together
+        for (auto& [name, service] : _services) {
+            service->requestStop();
+        }
+        for (auto& [name, service] : _services) {
+            for (auto* observer : _observers) {
+                observer->onServiceDestroyed(name, service.get());
+            }
+        }
+        services.swap(_services);
+        publishLocked();
+    }
+
+    // One joiner per service. The state outlives this call when a service
+    // misses the deadline; its joiner then finishes in the background and
+    // deletes the service once it has stopped.
+    struct JoinState {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::vector<bool> stopped;
+        size_t remaining = 0;
+    };
+    auto state = std::make_shared<JoinState>();
+    state->stopped.resize(services.size(), false);
+    state->remaining = services.size();
+
+    std::vector<std::string> names;
+    names.reserve(services.size());
+    for (auto& [name, service] : services) {
+        size_t index = names.size();
+        names.push_back(name);
+        auto join = [state, index, service = std::move(service)]() mutable {
+            service->shutdown();
+            service.reset();
+            std::lock_guard<std::mutex> lock(state->mtx);
+            state->stopped[index] = true;
+            state->remaining--;
+            state->cv.notify_all();
+        };
+        try {
+            std::thread(std::move(join)).detach();
+        } catch (const std::system_error&) {
+            // Out of threads: join this one inline instead
+            join();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    auto allStopped = [&state]() { return state->remaining == 0; };
+    if (deadline == std::chrono::steady_clock::time_point::max()) {
+        state->cv.wait(lock, allStopped);
+    } else {
+        state->cv.wait_until(lock, deadline, allStopped);
+    }
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (!state->stopped[i]) {
+            missed.push_back(names[i]);
+        }
+    }
+    lock.unlock();
+
+    if (!missed.empty()) {
+        for (const auto& name : missed) {
+            ChirpLogger::instance("ChirpFactory") << "Service '" << name << "' missed the shutdown deadline" << std::endl;
+        }
+        return ChirpError::TIMEOUT;
     }
-    
-    _services.clear();
     ChirpLogger::instance("ChirpFactory") << "All services shut down" << std::endl;
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpFactory::startAllServices(std::vector<std::string>& failed) {
+    failed.clear();
+
+    // Work on copies so startup handlers may call back into the factory
+    std::map<std::string, std::shared_ptr<IChirp>> pending;
+    std::map<std::string, std::set<std::string>> dependencies;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        pending = _services;
+        dependencies = _dependencies;
+    }
+    const size_t total = pending.size();
+    std::set<std::string> registered;
+    for (const auto& [name, service] : pending) {
+        registered.insert(name);
+    }
+
+    ChirpError::Error result = ChirpError::SUCCESS;
+    std::set<std::string> running;
+    std::set<std::string> skipped;
+    auto fail = [&](const std::string& name, ChirpError::Error e) {
+        ChirpLogger::instance("ChirpFactory") << "Service '" << name << "' not started: "
+                                              << ChirpError::errorToString(e) << std::endl;
+        failed.push_back(name);
+        skipped.insert(name);
+        if (result == ChirpError::SUCCESS) {
+            result = e;
+        }
+    };
+
+    size_t waves = 0;
+    while (!pending.empty()) {
+        // The next wave: every service whose dependencies are all running
+        std::vector<std::pair<std::string, std::shared_ptr<IChirp>>> wave;
+        bool dropped = false;
+        for (auto it = pending.begin(); it != pending.end();) {
+            ChirpError::Error unmet = ChirpError::SUCCESS;
+            bool ready = true;
+            for (const auto& dep : dependencies[it->first]) {
+                if (running.count(dep)) {
+                    continue;
+                }
+                if (!registered.count(dep)) {
+                    unmet = ChirpError::SERVICE_NOT_FOUND;
+                } else if (skipped.count(dep)) {
+                    unmet = ChirpError::SERVICE_NOT_STARTED;
+                }
+                ready = false;
+                if (unmet != ChirpError::SUCCESS) {
+                    break;
+                }
+            }
+
+            if (unmet != ChirpError::SUCCESS) {
+                fail(it->first, unmet);
+                dropped = true;
+                it = pending.erase(it);
+            } else if (ready) {
+                wave.emplace_back(it->first, std::move(it->second));
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (wave.empty()) {
+            if (!dropped) {
+                // addDependency() refuses cycles, so this is only a safeguard
+                for (const auto& [name, service] : pending) {
+                    fail(name, ChirpError::INVALID_CONFIGURATION);
+                }
+                pending.clear();
+            }
+            continue;
+        }
+
+        std::vector<ChirpError::Error> outcome = startWave(wave);
+        for (size_t i = 0; i < wave.size(); ++i) {
+            if (outcome[i] == ChirpError::SUCCESS) {
+                running.insert(wave[i].first);
+            } else {
+                fail(wave[i].first, outcome[i]);
+            }
+        }
+        waves++;
+    }
+
+    ChirpLogger::instance("ChirpFactory") << "Started " << total - failed.size() << " of " << total
+                                          << " services in " << waves << " waves" << std::endl;
+    return result;
+}
+
+std::vector<ChirpError::Error> ChirpFactory::startWave(
+    const std::vector<std::pair<std::string, std::shared_ptr<IChirp>>>& wave) {
+
+    std::vector<ChirpError::Error> outcome(wave.size(), ChirpError::SUCCESS);
+    std::vector<std::thread> startups;
+
+    // start() only spawns the loop thread, so the loops come up in parallel;
+    // startup handlers each get a helper thread to wait on them side by side
+    for (size_t i = 0; i < wave.size(); ++i) {
+        IChirp* service = wave[i].second.get();
+        ChirpError::Error e = service->start();
+        if (e == ChirpError::SERVICE_ALREADY_STARTED) {
+            continue;
+        }
+        if (e != ChirpError::SUCCESS) {
+            outcome[i] = e;
+            continue;
+        }
+
+        std::map<std::string, std::function<ChirpError::Error(std::vector<std::any>)>>* functions = nullptr;
+        service->getCbMap(functions);
+        if (!functions || functions->find(StartupMessage) == functions->end()) {
+            continue;
+        }
+        auto startup = [service, &result = outcome[i]]() {
+            result = service->syncMsg(StartupMessage);
+        };
+        try {
+            startups.emplace_back(startup);
+        } catch (const std::system_error&) {
+            startup();
+        }
+    }
+
+    for (auto& startup : startups) {
+        startup.join();
+    }
+    return outcome;
+}
+
+ChirpError::Error ChirpFactory::addDependency(const std::string& service_name, const std::string& depends_on) {
+    if (service_name.empty() || depends_on.empty() || service_name == depends_on) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Refuse the edge if service_name is already reachable from depends_on
+    std::vector<std::string> stack{depends_on};
+    std::set<std::string> visited;
+    while (!stack.empty()) {
+        std::string name = std::move(stack.back());
+        stack.pop_back();
+        if (name == service_name) {
+            ChirpLogger::instance("ChirpFactory") << "Dependency of '" << service_name << "' on '" << depends_on
+                                                  << "' would create a cycle" << std::endl;
+            return ChirpError::INVALID_CONFIGURATION;
+        }
+        auto it = _dependencies.find(name);
+        if (it == _dependencies.end() || !visited.insert(name).second) {
+            continue;
+        }
+        stack.insert(stack.end(), it->second.begin(), it->second.end());
+    }
+
+    _dependencies[service_name].insert(depends_on);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpFactory::removeDependency(const std::string& service_name, const std::string& depends_on) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _dependencies.find(service_name);
+    if (it == _dependencies.end() || it->second.erase(depends_on) == 0) {
+        return ChirpError::SERVICE_NOT_FOUND;
+    }
+    if (it->second.empty()) {
+        _dependencies.erase(it);
+    }
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpFactory::addObserver(IChirpFactoryObserver* observer) {
+    if (!observer) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (std::find(_observers.begin(), _observers.end(), observer) != _observers.end()) {
+        return ChirpError::HANDLER_ALREADY_EXISTS;
+    }
+    _observers.push_back(observer);
+    for (const auto& [name, service] : _services) {
+        observer->onServiceCreated(name, service.get());
+    }
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpFactory::removeObserver(IChirpFactoryObserver* observer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = std::find(_observers.begin(), _observers.end(), observer);
+    if (it == _observers.end()) {
+        return ChirpError::HANDLER_NOT_FOUND;
+    }
+    _observers.erase(it);
+    return ChirpError::SUCCESS;
 }
 
 const std::string& ChirpFactory::getVersion() const {
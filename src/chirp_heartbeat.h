@@ -0,0 +1,108 @@
+/**
+ * @file chirp_heartbeat.h
+ * @brief Liveness counters a message loop publishes for the watchdog
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * Only the loop thread writes a heartbeat; the watchdog reads it. The
+ * writer uses plain relaxed stores, no read-modify-write and no lock, so
+ * publishing costs the loop next to nothing. Each heartbeat fills its own
+ * cache line, so a watchdog scanning thousands of them never contends with
+ * the loops that update them.
+ *
+ * The loop also publishes the handler it is executing and when that handler
+ * started, under a sequence lock so a reader never sees a torn name. The
+ * name is only copied when it differs from the previous handler's.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "chirp_clock.h"
+
+struct alignas(64) ChirpHeartbeat {
+    // Loop iterations (spin) or poll() calls completed so far
+    std::atomic<uint64_t> iterations{0};
+    // ChirpClock time, in ns since its epoch, at which the loop last stopped
+    // waiting for work; 0 while it waits or is not running
+    std::atomic<int64_t> busySinceNs{0};
+    // Mirrors IChirp::setWatchDogMonitoring(), the one field not written by the loop
+    std::atomic<bool> monitored{false};
+
+    static constexpr size_t HandlerNameBytes = 48;   // Longer names are truncated
+
+    // Even while stable, odd while the loop rewrites the handler fields below
+    std::atomic<uint32_t> handlerSeq{0};
+    // ChirpClock time at which the running handler started; 0 between handlers
+    std::atomic<int64_t> handlerSinceNs{0};
+    std::array<std::atomic<uint64_t>, HandlerNameBytes / 8> handlerName{};
+
+    void beat() {
+        iterations.store(iterations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void markBusy() {
+        busySinceNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              ChirpClock::now().time_since_epoch()).count(),
+                          std::memory_order_relaxed);
+    }
+
+    void markIdle() {
+        busySinceNs.store(0, std::memory_order_relaxed);
+    }
+
+    // Loop thread only. Pass a name only when it differs from the last one published.
+    void enterHandler(int64_t sinceNs, const std::string* name) {
+        uint32_t seq = handlerSeq.load(std::memory_order_relaxed);
+        handlerSeq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        handlerSinceNs.store(sinceNs, std::memory_order_relaxed);
+        if (name) {
+            std::array<uint64_t, HandlerNameBytes / 8> words{};
+            std::memcpy(words.data(), name->data(), std::min(name->size(), HandlerNameBytes - 1));
+            for (size_t i = 0; i < words.size(); ++i) {
+                handlerName[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+        handlerSeq.store(seq + 2, std::memory_order_release);
+    }
+
+    void exitHandler() {
+        enterHandler(0, nullptr);
+    }
+
+    /**
+     * @brief Read the handler the loop is executing, from any thread
+     * @return false if no handler is running, or the loop kept rewriting it
+     */
+    bool currentHandler(std::string& name, int64_t& sinceNs) const {
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            uint32_t seq = handlerSeq.load(std::memory_order_acquire);
+            if (seq & 1) {
+                continue;
+            }
+
+            sinceNs = handlerSinceNs.load(std::memory_order_relaxed);
+            std::array<uint64_t, HandlerNameBytes / 8> words;
+            for (size_t i = 0; i < words.size(); ++i) {
+                words[i] = handlerName[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (handlerSeq.load(std::memory_order_relaxed) != seq) {
+                continue;
+            }
+
+            const char* bytes = reinterpret_cast<const char*>(words.data());
+            name.assign(bytes, strnlen(bytes, HandlerNameBytes));
+            return sinceNs != 0;
+        }
+        return false;
+    }
+};
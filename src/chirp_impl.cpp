@@ -15,9 +15,87 @@ ChirpImpl::ChirpImpl(const std::string& service_name, ChirpError::Error& error)
     error = ChirpError::SUCCESS;
 }
 
-void ChirpImpl::start() {
+ChirpError::Error ChirpImpl::start() {
     ChirpLogger::instance(_service_name) << "Starting " << _service_name << std::endl;
-    _nthread->startThread();
+    return _nthread->startThread();
+}
+
+ChirpError::Error ChirpImpl::startPolled() {
+    ChirpLogger::instance(_service_name) << "Starting " << _service_name << " in polled mode" << std::endl;
+    return _nthread->startPolled();
+}
+
+ChirpError::Error ChirpImpl::startLazy() {
+    ChirpLogger::instance(_service_name) << "Starting " << _service_name << " lazily" << std::endl;
+    return _nthread->startLazy();
+}
+
+ChirpError::Error ChirpImpl::poll(size_t budget, size_t& dispatched) {
+    return _nthread->poll(budget, dispatched);
+}
+
+ChirpError::Error ChirpImpl::runFor(const std::chrono::milliseconds& duration, size_t& dispatched) {
+    return _nthread->runFor(duration, dispatched);
+}
+
+int ChirpImpl::getPollFd() const {
+    return _nthread->getPollFd();
+}
+
+bool ChirpImpl::getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const {
+    return _nthread->getNextTimerDeadline(deadline);
+}
+
+void ChirpImpl::getServiceStats(ChirpServiceStats& stats) const {
+    _nthread->getServiceStats(stats);
+}
+
+void ChirpImpl::getQueueStats(ChirpQueueStats& stats) const {
+    _nthread->getQueueStats(stats);
+}
+
+std::shared_ptr<const ChirpHeartbeat> ChirpImpl::getHeartbeat() const {
+    return _nthread->getHeartbeat();
+}
+
+void ChirpImpl::setWatchDogMonitoring(bool enabled) {
+    _nthread->setWatchDogMonitoring(enabled);
+}
+
+void ChirpImpl::getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const {
+    _nthread->getExpiredMsgCounts(counts);
+}
+
+void ChirpImpl::setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold) {
+    _nthread->setSlowHandlerThreshold(threshold);
+}
+
+void ChirpImpl::getSlowHandlers(std::vector<ChirpSlowHandler>& log) const {
+    _nthread->getSlowHandlers(log);
+}
+
+void ChirpImpl::setSchedulingPolicy(IChirp::SchedulingPolicy policy) {
+    _nthread->setSchedulingPolicy(policy);
+}
+
+IChirp::SchedulingPolicy ChirpImpl::getSchedulingPolicy() const {
+    return _nthread->getSchedulingPolicy();
+}
+
+void ChirpImpl::setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn) {
+    _nthread->setLoadShedding(policy, maxSojourn);
+}
+
+IChirp::SheddingPolicy ChirpImpl::getLoadShedding() const {
+    return _nthread->getLoadShedding();
+}
+
+void ChirpImpl::setIdleTimeout(const std::chrono::milliseconds& timeout) {
+    _nthread->setIdleTimeout(timeout);
+}
+
+bool ChirpImpl::admitPost() {
+    return _nthread->admitPost();
 }
 
 void ChirpImpl::shutdown() {
@@ -26,6 +104,10 @@ void ChirpImpl::shutdown() {
     waitUntilServiceStopped();
 }
 
+void ChirpImpl::requestStop() {
+    _nthread->requestStop();
+}
+
 void ChirpImpl::waitUntilServiceStopped() {
     while (!_nthread->isThreadStopped()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -36,7 +118,9 @@ std::string ChirpImpl::getServiceName() {
     return _service_name;
 }
 
-ChirpError::Error ChirpImpl::enqueMsg(std::string& msgName, std::vector<std::any>& args) {
+ChirpError::Error ChirpImpl::enqueMsg(std::string& msgName, std::vector<std::any>& args,
+                                      std::chrono::steady_clock::time_point expiry,
+                                      std::chrono::steady_clock::time_point deadline) {
     ChirpError::Error result = ChirpError::SUCCESS;
     Message* msg = new (std::nothrow) Message(msgName, Message::MessageType::ASYNC, args);
     if (!msg) {
@@ -44,6 +128,8 @@ ChirpError::Error ChirpImpl::enqueMsg(std::string& msgName, std::vector<std::any
         ChirpLogger::instance(_service_name) << "Failed to allocate message for: " << msgName << std::endl;
         result = ChirpError::RESOURCE_ALLOCATION_FAILED;
     } else {
+        msg->setExpiry(expiry);
+        msg->setDeadline(deadline);
         result = _nthread->enqueueMsg(msg);
         if (result != ChirpError::SUCCESS) {
             delete msg; // Clean up the allocated message
@@ -52,6 +138,23 @@ ChirpError::Error ChirpImpl::enqueMsg(std::string& msgName, std::vector<std::any
     return result;
 }
 
+ChirpError::Error ChirpImpl::enqueDeferredMsg(std::string& msgName, std::vector<std::any>& args,
+                                              std::chrono::steady_clock::time_point due) {
+    ChirpError::Error result = ChirpError::SUCCESS;
+    Message* msg = new (std::nothrow) Message(msgName, Message::MessageType::ASYNC, args);
+    if (!msg) {
+        // Log error but continue - message allocation failure shouldn't crash the service
+        ChirpLogger::instance(_service_name) << "Failed to allocate deferred message for: " << msgName << std::endl;
+        result = ChirpError::RESOURCE_ALLOCATION_FAILED;
+    } else {
+        result = _nthread->enqueueDeferredMsg(msg, due);
+        if (result != ChirpError::SUCCESS) {
+            delete msg; // Clean up the allocated message
+        }
+    }
+    return result;
+}
+
 ChirpError::Error ChirpImpl::enqueSyncMsg(std::string& msgName, std::vector<std::any>& args) {
     ChirpError::Error result = ChirpError::SUCCESS;
     Message* msg = new (std::nothrow) Message(msgName, Message::MessageType::SYNC, args);
@@ -72,6 +175,14 @@ void ChirpImpl::getCbMap(std::map<std::string, std::function<ChirpError::Error(s
     _nthread->getCbMap(funcMap);
 }
 
+ChirpError::Error ChirpImpl::addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback) {
+    return _nthread->addFdWatch(fd, events, std::move(callback));
+}
+
+ChirpError::Error ChirpImpl::removeFdWatch(int fd) {
+    return _nthread->removeFdWatch(fd);
+}
+
 void ChirpImpl::addChirpTimer(ChirpTimer* timer) {
     _nthread->addChirpTimer(timer);
 }
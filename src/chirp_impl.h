@@ -1,6 +1,10 @@
 #pragma once
 #include "chirp_error.h"
 #include "chirp_timer.h"
+#include "ichirp.h"
+
+struct ChirpServiceStats;
+struct ChirpHeartbeat;
 
 class ChirpImpl {
 public:
@@ -8,12 +12,38 @@ public:
     ~ChirpImpl() = default;
 
     explicit ChirpImpl(const std::string& service_name, ChirpError::Error& error);
-    void start();
+    ChirpError::Error start();
+    ChirpError::Error startPolled();
+    ChirpError::Error startLazy();
     void shutdown();
+    void requestStop();
+    ChirpError::Error poll(size_t budget, size_t& dispatched);
+    ChirpError::Error runFor(const std::chrono::milliseconds& duration, size_t& dispatched);
+    int getPollFd() const;
+    bool getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const;
+    void getServiceStats(ChirpServiceStats& stats) const;
+    void getQueueStats(ChirpQueueStats& stats) const;
+    std::shared_ptr<const ChirpHeartbeat> getHeartbeat() const;
+    void setWatchDogMonitoring(bool enabled);
+    void getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const;
+    void setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold);
+    void getSlowHandlers(std::vector<ChirpSlowHandler>& log) const;
+    void setSchedulingPolicy(IChirp::SchedulingPolicy policy);
+    IChirp::SchedulingPolicy getSchedulingPolicy() const;
+    void setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn);
+    IChirp::SheddingPolicy getLoadShedding() const;
+    void setIdleTimeout(const std::chrono::milliseconds& timeout);
+    bool admitPost();
     std::string getServiceName();
-    ChirpError::Error enqueMsg(std::string& msgName, std::vector<std::any>& args);
+    ChirpError::Error enqueMsg(std::string& msgName, std::vector<std::any>& args,
+                               std::chrono::steady_clock::time_point expiry = {},
+                               std::chrono::steady_clock::time_point deadline = {});
     ChirpError::Error enqueSyncMsg(std::string& msgName, std::vector<std::any>& args);
+    ChirpError::Error enqueDeferredMsg(std::string& msgName, std::vector<std::any>& args,
+                                       std::chrono::steady_clock::time_point due);
     void getCbMap(std::map<std::string, std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap);
+    ChirpError::Error addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback);
+    ChirpError::Error removeFdWatch(int fd);
     void addChirpTimer(ChirpTimer* timer);
     void removeChirpTimer(ChirpTimer* timer);
 
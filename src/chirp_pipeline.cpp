@@ -0,0 +1,230 @@
+/**
+ * @file chirp_pipeline.cpp
+ * @brief Implementation of credit-based service pipelines
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#include <new>
+
+#include "ichirp.h"
+#include "chirp_pipeline.h"
+#include "chirp_clock.h"
+
+// ===== PipelineStage =====
+
+PipelineStage::PipelineStage(const std::string& name, IChirpPipeline::StageHandler handler, size_t capacity)
+    : _name(name), _handler(std::move(handler)), _input(capacity) {
+}
+
+bool PipelineStage::offer(std::any& item) {
+
+    if (_input.tryPush(item)) {
+        schedule();
+        return true;
+    }
+
+    // Out of credit. Raise the flag, then retry once in case the consumer
+    // freed a slot before it could see the flag.
+    _creditWanted.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_input.tryPush(item)) {
+        schedule();
+        return true;
+    }
+    return false;
+}
+
+void PipelineStage::drain() {
+
+    _drainScheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Downstream schedules us again once it grants the credit we are waiting for
+    if (_hasPending && !forwardPending()) {
+        return;
+    }
+
+    for (size_t n = 0; n < DrainBatch; ++n) {
+        std::any item;
+        if (!_input.tryPop(item)) {
+            return;
+        }
+
+        // Grant the freed slot back to a producer that ran out of credit
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_creditWanted.load() && _creditWanted.exchange(false) && _prev) {
+            _prev->schedule();
+        }
+
+        _processed.fetch_add(1, std::memory_order_relaxed);
+        if (_handler(item) != ChirpError::SUCCESS) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (_next) {
+            _pending = std::move(item);
+            _hasPending = true;
+            if (!forwardPending()) {
+                return;
+            }
+        }
+    }
+
+    // Batch exhausted; go to the back of the queue so other messages get a turn
+    schedule();
+}
+
+void PipelineStage::schedule() {
+
+    if (!_drainScheduled.exchange(true) && _service) {
+        std::string msgName = DrainMessage;
+        std::vector<std::any> args{msgName};
+        (void)_service->enqueMsg(msgName, args);
+    }
+}
+
+bool PipelineStage::forwardPending() {
+
+    if (!_next->offer(_pending)) {
+        return false;
+    }
+    _pending.reset();
+    _hasPending = false;
+    return true;
+}
+
+void PipelineStage::fillStats(PipelineStageStats& stats, std::chrono::steady_clock::time_point since) const {
+
+    stats.name = _name;
+    stats.processed = _processed.load(std::memory_order_relaxed);
+    stats.dropped = _dropped.load(std::memory_order_relaxed);
+    stats.occupancy = _input.size();
+    stats.capacity = _input.capacity();
+
+    std::chrono::duration<double> elapsed = ChirpClock::now() - since;
+    stats.itemsPerSecond = (elapsed.count() > 0.0) ? static_cast<double>(stats.processed) / elapsed.count() : 0.0;
+}
+
+// ===== ChirpPipeline =====
+
+// Static factory that hides concrete type from callers
+IChirpPipeline* IChirpPipeline::createPipeline(IChirpFactory* factory) {
+
+    ChirpPipeline* pipeline = new (std::nothrow) ChirpPipeline(factory);
+    return static_cast<IChirpPipeline*>(pipeline);
+}
+
+ChirpPipeline::ChirpPipeline(IChirpFactory* factory)
+    : _factory(factory) {
+}
+
+ChirpPipeline::~ChirpPipeline() {
+
+    stop();
+}
+
+ChirpError::Error ChirpPipeline::addStage(const std::string& serviceName,
+                                          StageHandler handler,
+                                          size_t capacity) {
+
+    if (_running) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    if (serviceName.empty() || !handler || capacity == 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    for (const auto& stage : _stages) {
+        if (stage->_name == serviceName) {
+            return ChirpError::SERVICE_ALREADY_EXISTS;
+        }
+    }
+
+    auto stage = std::make_unique<PipelineStage>(serviceName, std::move(handler), capacity);
+    if (!_stages.empty()) {
+        stage->_prev = _stages.back().get();
+        _stages.back()->_next = stage.get();
+    }
+    _stages.push_back(std::move(stage));
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpPipeline::start() {
+
+    if (!_factory || _stages.empty()) {
+        return ChirpError::INVALID_CONFIGURATION;
+    }
+    if (_running) {
+        return ChirpError::SERVICE_ALREADY_STARTED;
+    }
+
+    for (auto& stage : _stages) {
+        IChirp* service = nullptr;
+        auto e = _factory->createService(stage->_name, &service);
+        if (e == ChirpError::SUCCESS) {
+            stage->_service = service;
+            e = service->registerMsgHandler(PipelineStage::DrainMessage, stage.get(), &PipelineStage::drain);
+        }
+        if (e == ChirpError::SUCCESS) {
+            e = service->start();
+        }
+        if (e != ChirpError::SUCCESS) {
+            _running = true;
+            stop();
+            return e;
+        }
+    }
+
+    _startTime = ChirpClock::now();
+    _running = true;
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpPipeline::stop() {
+
+    if (!_running) {
+        return ChirpError::SUCCESS;
+    }
+
+    // Neighbouring stages post to each other, so every thread must be
+    // stopped before any service is destroyed
+    for (auto& stage : _stages) {
+        if (stage->_service) {
+            stage->_service->shutdown();
+        }
+    }
+    for (auto& stage : _stages) {
+        if (stage->_service) {
+            _factory->destroyService(stage->_name);
+        }
+    }
+
+    // Rebuild the stages so a restart begins with empty rings and fresh counters
+    std::vector<std::unique_ptr<PipelineStage>> stages = std::move(_stages);
+    _stages.clear();
+    _running = false;
+    for (auto& stage : stages) {
+        (void)addStage(stage->_name, stage->handler(), stage->capacity());
+    }
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpPipeline::push(std::any item) {
+
+    if (!_running) {
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    return _stages.front()->offer(item) ? ChirpError::SUCCESS : ChirpError::NO_CREDIT;
+}
+
+ChirpError::Error ChirpPipeline::getStageStats(std::vector<PipelineStageStats>& stats) const {
+
+    stats.clear();
+    stats.resize(_stages.size());
+    for (size_t i = 0; i < _stages.size(); ++i) {
+        _stages[i]->fillStats(stats[i], _startTime);
+    }
+    return ChirpError::SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file chirp_pipeline.h
+ * @brief Concrete pipeline built from factory services
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#pragma once
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ichirp_pipeline.h"
+#include "spsc_ring.h"
+
+class IChirp;
+
+class PipelineStage {
+
+public:
+    static constexpr const char* DrainMessage = "_PipelineDrain";
+    static constexpr size_t DrainBatch = 64;
+
+    PipelineStage(const std::string& name, IChirpPipeline::StageHandler handler, size_t capacity);
+
+    // Producer side: called by the upstream stage or by IChirpPipeline::push()
+    bool offer(std::any& item);
+
+    // Consumer side: the stage service's handler for DrainMessage
+    void drain();
+
+    void schedule();
+    const IChirpPipeline::StageHandler& handler() const { return _handler; }
+    size_t capacity() const { return _input.capacity(); }
+    void fillStats(PipelineStageStats& stats, std::chrono::steady_clock::time_point since) const;
+
+    std::string _name;
+    IChirp* _service = nullptr;
+    PipelineStage* _prev = nullptr;
+    PipelineStage* _next = nullptr;
+
+private:
+    bool forwardPending();
+
+    IChirpPipeline::StageHandler _handler;
+    SpscRing<std::any> _input;
+
+    // Item that passed this stage but found no credit downstream.
+    // Only touched on this stage's service thread.
+    std::any _pending;
+    bool _hasPending = false;
+
+    std::atomic<bool> _drainScheduled{false};
+    // Set by the producer when it ran out of credit; the consumer
+    // wakes the producer up again when it frees a slot
+    std::atomic<bool> _creditWanted{false};
+
+    std::atomic<uint64_t> _processed{0};
+    std::atomic<uint64_t> _dropped{0};
+};
+
+class ChirpPipeline : public IChirpPipeline {
+
+public:
+    explicit ChirpPipeline(IChirpFactory* factory);
+    ~ChirpPipeline() override;
+
+    using IChirpPipeline::addStage;
+    ChirpError::Error addStage(const std::string& serviceName,
+                               StageHandler handler,
+                               size_t capacity) override;
+    ChirpError::Error start() override;
+    ChirpError::Error stop() override;
+    ChirpError::Error push(std::any item) override;
+    ChirpError::Error getStageStats(std::vector<PipelineStageStats>& stats) const override;
+
+private:
+    IChirpFactory* _factory = nullptr;
+    std::vector<std::unique_ptr<PipelineStage>> _stages;
+    std::chrono::steady_clock::time_point _startTime{};
+    bool _running = false;
+};
@@ -0,0 +1,164 @@
+/**
+ * @file chirp_simulation.cpp
+ * @brief Implementation of the virtual-time scheduler
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#include <algorithm>
+#include <new>
+
+#include "ichirp.h"
+#include "chirp_simulation.h"
+#include "chirp_clock.h"
+#include "chirp_threads.h"
+#include "chirp_impl.h"
+
+// Static factory that hides concrete type from callers
+IChirpSimulation* IChirpSimulation::createSimulation(IChirpFactory* factory) {
+
+    ChirpSimulation* sim = new (std::nothrow) ChirpSimulation(factory);
+    return static_cast<IChirpSimulation*>(sim);
+}
+
+ChirpSimulation::ChirpSimulation(IChirpFactory* factory)
+    : _factory(factory) {
+}
+
+ChirpSimulation::~ChirpSimulation() {
+
+    stop();
+}
+
+ChirpError::Error ChirpSimulation::start() {
+
+    if (!_factory) {
+        return ChirpError::INVALID_CONFIGURATION;
+    }
+    if (_running) {
+        return ChirpError::SERVICE_ALREADY_STARTED;
+    }
+
+    _startTime = std::chrono::steady_clock::now();
+    ChirpClock::useVirtualTime(_startTime);
+    _running = true;
+
+    // Sorted names give every run the same polling order
+    std::vector<std::string> names = _factory->listServiceNames();
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        auto e = attach(_factory->getService(name));
+        if (e != ChirpError::SUCCESS) {
+            stop();
+            return e;
+        }
+    }
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpSimulation::stop() {
+
+    if (_running) {
+        ChirpClock::useSystemTime();
+        _running = false;
+    }
+    _services.clear();
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpSimulation::attach(IChirp* service) {
+
+    if (!service) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    if (std::find(_services.begin(), _services.end(), service) != _services.end()) {
+        return ChirpError::SUCCESS;
+    }
+
+    auto e = service->start(IChirp::RunMode::POLLED);
+    if (e == ChirpError::SERVICE_ALREADY_STARTED) {
+        // Acceptable only if the service was started in polled mode
+        e = service->poll(0);
+    }
+    if (e != ChirpError::SUCCESS) {
+        return e;
+    }
+
+    _services.push_back(service);
+    return ChirpError::SUCCESS;
+}
+
+size_t ChirpSimulation::runUntilIdle() {
+
+    size_t total = 0;
+    size_t round = 0;
+
+    // One message per service per round interleaves services deterministically
+    do {
+        round = 0;
+        for (IChirp* service : _services) {
+            size_t dispatched = 0;
+            service->poll(1, &dispatched);
+            round += dispatched;
+        }
+        total += round;
+    } while (round > 0);
+
+    return total;
+}
+
+size_t ChirpSimulation::runFor(const std::chrono::nanoseconds& duration) {
+
+    size_t total = runUntilIdle();
+    if (!_running) {
+        return total;
+    }
+
+    auto end = ChirpClock::now() + duration;
+
+    while (true) {
+        std::chrono::steady_clock::time_point deadline{};
+        if (!nextTimerDeadline(deadline) || deadline > end) {
+            break;
+        }
+
+        // Always move forward so a timer that is due but cannot fire
+        // does not pin the simulation in place
+        auto now = ChirpClock::now();
+        ChirpClock::advanceTo(std::max(deadline, now + std::chrono::nanoseconds(1)));
+        total += runUntilIdle();
+
+        if (ChirpClock::now() >= end) {
+            break;
+        }
+    }
+
+    ChirpClock::advanceTo(end);
+    total += runUntilIdle();
+    return total;
+}
+
+std::chrono::nanoseconds ChirpSimulation::elapsed() const {
+
+    if (!_running) {
+        return std::chrono::nanoseconds(0);
+    }
+    return ChirpClock::now() - _startTime;
+}
+
+bool ChirpSimulation::nextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const {
+
+    bool found = false;
+    for (IChirp* service : _services) {
+        std::chrono::steady_clock::time_point candidate{};
+        if (service->_impl && service->_impl->getNextTimerDeadline(candidate)) {
+            if (!found || candidate < deadline) {
+                deadline = candidate;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file chirp_simulation.h
+ * @brief Concrete virtual-time scheduler
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ichirp_simulation.h"
+
+class ChirpSimulation : public IChirpSimulation {
+
+public:
+    explicit ChirpSimulation(IChirpFactory* factory);
+    ~ChirpSimulation() override;
+
+    ChirpError::Error start() override;
+    ChirpError::Error stop() override;
+    ChirpError::Error attach(IChirp* service) override;
+    size_t runUntilIdle() override;
+    size_t runFor(const std::chrono::nanoseconds& duration) override;
+    std::chrono::nanoseconds elapsed() const override;
+
+private:
+
+    bool nextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const;
+
+    IChirpFactory* _factory = nullptr;
+    std::vector<IChirp*> _services;
+    std::chrono::steady_clock::time_point _startTime{};
+    bool _running = false;
+};
@@ -7,14 +7,198 @@ ChirpThread::ChirpThread(const std::string& service_name)
       _t(nullptr) {
 
     _mloop.setServiceName(service_name);
+    _mloop.setActivation([this]() { activate(); }, [this]() { return releaseThread(); });
 }
 
-void ChirpThread::startThread() {
+ChirpError::Error ChirpThread::startThread() {
 
-    _t = new std::thread(&MessageLoop::spin, &_mloop);
+    if (_state == ThreadState::STARTED || _state == ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot start: thread already started" << std::endl;
+        return ChirpError::SERVICE_ALREADY_STARTED;
+    }
+
+    // Reset the loop before the thread exists so a stop() racing with the
+    // thread start-up is never overwritten by the spinning thread.
+    _mloop.prepare();
+    _polled = false;
     _state = ThreadState::STARTED;
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    _t = new (std::nothrow) std::thread(&MessageLoop::spin, &_mloop);
+    if (!_t) {
+        _state = ThreadState::NOT_STARTED;
+        return ChirpError::THREAD_ERROR;
+    }
+    _state = ThreadState::RUNNING;
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpThread::startPolled() {
+
+    if (_state == ThreadState::STARTED || _state == ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot start polled: thread already started" << std::endl;
+        return ChirpError::SERVICE_ALREADY_STARTED;
+    }
+
+    // No thread is spawned. The owner drives the loop through poll()/runFor()
+    _mloop.prepare();
+    _polled = true;
+    _state = ThreadState::RUNNING;
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpThread::startLazy() {
+
+    if (_state == ThreadState::STARTED || _state == ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot start lazily: thread already started" << std::endl;
+        return ChirpError::SERVICE_ALREADY_STARTED;
+    }
+
+    // The first post, delayed post or timer spawns the thread through activate()
+    _mloop.prepare();
+    _polled = false;
+    {
+        std::lock_guard<std::mutex> lock(_activation_mtx);
+        _lazy = true;
+        _mloop.setDormant(true);
+    }
     _state = ThreadState::RUNNING;
+    return ChirpError::SUCCESS;
+}
+
+void ChirpThread::activate() {
+
+    std::lock_guard<std::mutex> lock(_activation_mtx);
+    if (!_lazy || !_mloop.isDormant()) {
+        return;
+    }
+
+    // A thread that went idle has left spin() already or is about to
+    if (_t != nullptr) {
+        _t->join();
+        delete _t;
+        _t = nullptr;
+    }
+    _mloop.setDormant(false);
+    _t = new (std::nothrow) std::thread(&MessageLoop::spin, &_mloop);
+    if (!_t) {
+        ChirpLogger::instance(_service_name) << "Failed to activate: no loop thread" << std::endl;
+        _mloop.setDormant(true);
+        return;
+    }
+    _mloop.countActivation();
+}
+
+bool ChirpThread::releaseThread() {
+
+    // Runs on the loop thread. Going dormant before the final look for work
+    // pairs with posters publishing work before they check for dormancy.
+    std::lock_guard<std::mutex> lock(_activation_mtx);
+    if (!_lazy) {
+        return false;
+    }
+    _mloop.setDormant(true);
+    if (_mloop.hasWork()) {
+        _mloop.setDormant(false);
+        return false;
+    }
+    ChirpLogger::instance(_service_name) << "Idle, releasing loop thread" << std::endl;
+    return true;
+}
+
+ChirpError::Error ChirpThread::poll(size_t budget, size_t& dispatched) {
+
+    dispatched = 0;
+    if (!_polled || _state != ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot poll: service not started in polled mode" << std::endl;
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    dispatched = _mloop.poll(budget);
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error ChirpThread::runFor(const std::chrono::milliseconds& duration, size_t& dispatched) {
+
+    dispatched = 0;
+    if (!_polled || _state != ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot run: service not started in polled mode" << std::endl;
+        return ChirpError::INVALID_SERVICE_STATE;
+    }
+    dispatched = _mloop.runFor(duration);
+    return ChirpError::SUCCESS;
+}
+
+int ChirpThread::getPollFd() const {
+
+    return _mloop.getPollFd();
+}
+
+bool ChirpThread::getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const {
+
+    return _mloop.getNextTimerDeadline(deadline);
+}
+
+void ChirpThread::getServiceStats(ChirpServiceStats& stats) const {
+
+    _mloop.getServiceStats(stats);
+}
+
+void ChirpThread::getQueueStats(ChirpQueueStats& stats) const {
+
+    _mloop.getQueueStats(stats);
+}
+
+std::shared_ptr<const ChirpHeartbeat> ChirpThread::getHeartbeat() const {
+
+    return _mloop.getHeartbeat();
+}
+
+void ChirpThread::setWatchDogMonitoring(bool enabled) {
+
+    _mloop.setWatchDogMonitoring(enabled);
+}
+
+void ChirpThread::getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const {
+
+    _mloop.getExpiredMsgCounts(counts);
+}
+
+void ChirpThread::setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold) {
+
+    _mloop.setSlowHandlerThreshold(threshold);
+}
+
+void ChirpThread::getSlowHandlers(std::vector<ChirpSlowHandler>& log) const {
+
+    _mloop.getSlowHandlers(log);
+}
+
+void ChirpThread::setSchedulingPolicy(IChirp::SchedulingPolicy policy) {
+
+    _mloop.setSchedulingPolicy(policy);
+}
+
+IChirp::SchedulingPolicy ChirpThread::getSchedulingPolicy() const {
+
+    return _mloop.getSchedulingPolicy();
+}
+
+void ChirpThread::setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn) {
+
+    _mloop.setLoadShedding(policy, maxSojourn);
+}
+
+IChirp::SheddingPolicy ChirpThread::getLoadShedding() const {
+
+    return _mloop.getLoadShedding();
+}
+
+void ChirpThread::setIdleTimeout(const std::chrono::milliseconds& timeout) {
+
+    _mloop.setIdleTimeout(timeout);
+}
+
+bool ChirpThread::admitPost() {
+
+    return _mloop.admitPost();
 }
 
 ChirpError::Error ChirpThread::enqueueMsg(Message* m) {
@@ -41,6 +225,18 @@ ChirpError::Error ChirpThread::enqueueSyncMsg(Message* m) {
     return result;
 }
 
+ChirpError::Error ChirpThread::enqueueDeferredMsg(Message* m, std::chrono::steady_clock::time_point due) {
+
+    ChirpError::Error result = ChirpError::SUCCESS;
+    if (_state != ThreadState::STARTED && _state != ThreadState::RUNNING) {
+        ChirpLogger::instance(_service_name) << "Cannot enqueue deferred message: thread not in STARTED or RUNNING state" << std::endl;
+        result = ChirpError::INVALID_SERVICE_STATE;
+    } else {
+        _mloop.enqueueDeferred(m, due);
+    }
+    return result;
+}
+
 void ChirpThread::getCbMap(std::map<std::string, 
                            std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap) {
 
@@ -50,6 +246,12 @@ void ChirpThread::getCbMap(std::map<std::string,
 void ChirpThread::stopThread() {  
 
     _mloop.stop();
+    {
+        // No activation may race with the join below
+        std::lock_guard<std::mutex> lock(_activation_mtx);
+        _lazy = false;
+        _mloop.setDormant(false);
+    }
     if (_t != nullptr) {
         _t->join();
         delete _t;
@@ -60,6 +262,12 @@ void ChirpThread::stopThread() {
     _state = ThreadState::STOPPED;
 }
 
+void ChirpThread::requestStop() {
+
+    // Only signals the loop; stopThread() still joins and drains it
+    _mloop.requestStop();
+}
+
 bool ChirpThread::isThreadStopped() {
 
     return _state == ThreadState::STOPPED;
@@ -76,6 +284,16 @@ ChirpThread::~ChirpThread() {
     }
 }
 
+ChirpError::Error ChirpThread::addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback) {
+
+    return _mloop.addFdWatch(fd, events, std::move(callback));
+}
+
+ChirpError::Error ChirpThread::removeFdWatch(int fd) {
+
+    return _mloop.removeFdWatch(fd);
+}
+
 void ChirpThread::addChirpTimer(ChirpTimer* timer) {
 
     _mloop.addChirpTimer(timer);
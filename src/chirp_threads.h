@@ -13,13 +13,36 @@ public:
 
     explicit ChirpThread(const std::string& service_name);
 
-    void startThread();
+    ChirpError::Error startThread();
+    ChirpError::Error startPolled();
+    ChirpError::Error startLazy();
     void stopThread();
+    void requestStop();
+    ChirpError::Error poll(size_t budget, size_t& dispatched);
+    ChirpError::Error runFor(const std::chrono::milliseconds& duration, size_t& dispatched);
+    int getPollFd() const;
+    bool getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const;
+    void getServiceStats(ChirpServiceStats& stats) const;
+    void getQueueStats(ChirpQueueStats& stats) const;
+    std::shared_ptr<const ChirpHeartbeat> getHeartbeat() const;
+    void setWatchDogMonitoring(bool enabled);
+    void getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const;
+    void setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold);
+    void getSlowHandlers(std::vector<ChirpSlowHandler>& log) const;
+    void setSchedulingPolicy(IChirp::SchedulingPolicy policy);
+    IChirp::SchedulingPolicy getSchedulingPolicy() const;
+    void setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn);
+    IChirp::SheddingPolicy getLoadShedding() const;
+    void setIdleTimeout(const std::chrono::milliseconds& timeout);
+    bool admitPost();
     ChirpError::Error enqueueMsg(Message* m);
     ChirpError::Error enqueueSyncMsg(Message* m);
+    ChirpError::Error enqueueDeferredMsg(Message* m, std::chrono::steady_clock::time_point due);
     void getCbMap(std::map<std::string, 
                   std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap);
     bool isThreadStopped();
+    ChirpError::Error addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback);
+    ChirpError::Error removeFdWatch(int fd);
     void addChirpTimer(ChirpTimer* timer);
     void removeChirpTimer(ChirpTimer* timer);        
 
@@ -36,5 +59,13 @@ enum class ThreadState {
     std::thread* _t;
     std::string _service_name;
     ThreadState _state;
+    bool _polled = false;
+
+    // Lazy mode: the loop thread comes and goes with the work. Spawning,
+    // joining and releasing it are serialized by _activation_mtx.
+    void activate();
+    bool releaseThread();
+    bool _lazy = false;
+    std::mutex _activation_mtx;
 };
 
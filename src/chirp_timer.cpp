@@ -8,7 +8,9 @@
 
 #include "chirp_timer.h"
 #include "chirp_logger.h"
+#include "chirp_clock.h"
 #include "ichirp.h"
+#include <algorithm>
 #include <iostream>
 
 
@@ -36,6 +38,13 @@ ChirpTimer::~ChirpTimer() {
 
 ChirpError::Error ChirpTimer::configure( std::string messageToDeliver,
                                        const std::chrono::milliseconds& duration) {
+
+    return configure(messageToDeliver, duration, TimerMode::PERIODIC);
+}
+
+ChirpError::Error ChirpTimer::configure(std::string messageToDeliver,
+                                       const std::chrono::nanoseconds& duration,
+                                       TimerMode mode) {
                                         
     ChirpError::Error result = ChirpError::SUCCESS;
     std::lock_guard<std::mutex> lock(_configMutex);
@@ -53,11 +62,90 @@ ChirpError::Error ChirpTimer::configure( std::string messageToDeliver,
     else {
         _messageToDeliver = messageToDeliver;
         _duration = duration;
+        _mode = mode;
+        _hasDeadline = false;
+        _configGeneration.fetch_add(1, std::memory_order_release);
     }
     
     return result;
 }
 
+ChirpError::Error ChirpTimer::configureAt(std::string messageToDeliver,
+                                         const std::chrono::steady_clock::time_point& deadline) {
+
+    ChirpError::Error result = ChirpError::SUCCESS;
+    std::lock_guard<std::mutex> lock(_configMutex);
+
+    if (_state == TimerState::RUNNING) {
+        ChirpLogger::instance("ChirpTimer") << "Cannot configure timer while it is running" << std::endl;
+        result = ChirpError::INVALID_SERVICE_STATE;
+    }
+    else if (messageToDeliver.empty()) {
+        ChirpLogger::instance("ChirpTimer") << "Invalid message to deliver" << std::endl;
+        result = ChirpError::INVALID_ARGUMENTS;
+    }
+    else {
+        _messageToDeliver = messageToDeliver;
+        _duration = std::chrono::nanoseconds(0);
+        _mode = TimerMode::ONE_SHOT;
+        _hasDeadline = true;
+        _deadline = deadline;
+        _configGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    return result;
+}
+
+IChirpTimer::TimerMode ChirpTimer::getMode() const {
+
+    std::lock_guard<std::mutex> lock(_configMutex);
+    return _mode;
+}
+
+ChirpError::Error ChirpTimer::setMissedTickPolicy(MissedTickPolicy policy) {
+
+    _missedTickPolicy = policy;
+    return ChirpError::SUCCESS;
+}
+
+IChirpTimer::MissedTickPolicy ChirpTimer::getMissedTickPolicy() const {
+
+    return _missedTickPolicy.load();
+}
+
+uint64_t ChirpTimer::getMissedTicks() const {
+
+    return _missedTicks.load();
+}
+
+uint64_t ChirpTimer::getLastMissedTicks() const {
+
+    return _lastMissedTicks.load();
+}
+
+void ChirpTimer::recordMissedTicks(uint64_t missed, bool folded) {
+
+    _missedTicks += missed;
+    if (folded) {
+        _lastMissedTicks = missed;
+    }
+}
+
+bool ChirpTimer::getDeadline(std::chrono::steady_clock::time_point& deadline) const {
+
+    std::lock_guard<std::mutex> lock(_configMutex);
+    if (_hasDeadline) {
+        deadline = _deadline;
+    }
+    return _hasDeadline;
+}
+
+void ChirpTimer::expire() {
+
+    std::lock_guard<std::mutex> lock(_configMutex);
+    _state = TimerState::STOPPED;
+}
+
 ChirpError::Error ChirpTimer::start() {
 
     std::lock_guard<std::mutex> lock(_configMutex);
@@ -69,7 +157,7 @@ ChirpError::Error ChirpTimer::start() {
     if (result == ChirpError::SUCCESS) {
         
         // Record the start time
-        _startTime = std::chrono::steady_clock::now();
+        _startTime = ChirpClock::now();
         _state = TimerState::RUNNING;
     }
     
@@ -95,10 +183,118 @@ bool ChirpTimer::isRunning() const {
 
 std::chrono::milliseconds ChirpTimer::getDuration() const {
 
+    std::lock_guard<std::mutex> lock(_configMutex);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(_duration);
+}
+
+std::chrono::nanoseconds ChirpTimer::getDurationNs() const {
+
     std::lock_guard<std::mutex> lock(_configMutex);
     return _duration;
 }
 
+ChirpError::Error ChirpTimer::setSlack(const std::chrono::nanoseconds& slack) {
+
+    if (slack.count() < 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+    _slack = slack;
+    return ChirpError::SUCCESS;
+}
+
+std::chrono::nanoseconds ChirpTimer::getSlack() const {
+
+    return _slack.load();
+}
+
+void ChirpTimer::recordLateness(std::chrono::nanoseconds lateness) {
+
+    uint64_t ns = lateness.count() > 0 ? static_cast<uint64_t>(lateness.count()) : 0;
+
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    if (_latenessSamples == 0) {
+        _latenessMinNs = ns;
+        _latenessMaxNs = ns;
+    } else {
+        if (!_latenessHistogram) {
+            // Second sample: the first one is still available as min == max
+            _latenessHistogram = std::make_unique<LatenessHistogram>();
+            _latenessHistogram->counts[LatenessHistogram::bucketOf(_latenessMinNs)]++;
+        }
+        _latenessMinNs = std::min(_latenessMinNs, ns);
+        _latenessMaxNs = std::max(_latenessMaxNs, ns);
+    }
+    if (_latenessHistogram) {
+        _latenessHistogram->counts[LatenessHistogram::bucketOf(ns)]++;
+    }
+    _latenessSamples++;
+    _latenessSumNs += ns;
+}
+
+ChirpError::Error ChirpTimer::getLatenessStats(TimerLatenessStats& stats) const {
+
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    stats = TimerLatenessStats{};
+    if (_latenessSamples == 0) {
+        return ChirpError::SUCCESS;
+    }
+
+    stats.samples = _latenessSamples;
+    stats.min = std::chrono::nanoseconds(_latenessMinNs);
+    stats.max = std::chrono::nanoseconds(_latenessMaxNs);
+    stats.avg = std::chrono::nanoseconds(_latenessSumNs / _latenessSamples);
+    stats.p99 = stats.max;
+
+    if (_latenessHistogram) {
+        uint64_t target = (_latenessSamples * 99 + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < LatenessHistogram::Buckets; ++b) {
+            seen += _latenessHistogram->counts[b];
+            if (seen >= target) {
+                uint64_t bound = LatenessHistogram::upperBoundOf(b);
+                bound = std::min(std::max(bound, _latenessMinNs), _latenessMaxNs);
+                stats.p99 = std::chrono::nanoseconds(bound);
+                break;
+            }
+        }
+    }
+    return ChirpError::SUCCESS;
+}
+
+void ChirpTimer::resetLatenessStats() {
+
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    _latenessSamples = 0;
+    _latenessSumNs = 0;
+    _latenessMinNs = 0;
+    _latenessMaxNs = 0;
+    // Kept, so that a periodic timer does not allocate it again on firing
+    if (_latenessHistogram) {
+        _latenessHistogram->counts.fill(0);
+    }
+}
+
+size_t ChirpTimer::LatenessHistogram::bucketOf(uint64_t ns) {
+
+    if (ns < SubBuckets) {
+        return static_cast<size_t>(ns);
+    }
+    // Index of the highest set bit selects the power of two, the next three bits the sub-bucket
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(ns));
+    size_t sub = static_cast<size_t>(ns >> (exponent - 3)) & (SubBuckets - 1);
+    return std::min(SubBuckets * (exponent - 2) + sub, Buckets - 1);
+}
+
+uint64_t ChirpTimer::LatenessHistogram::upperBoundOf(size_t bucket) {
+
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+    size_t exponent = bucket / SubBuckets + 2;
+    uint64_t sub = bucket % SubBuckets;
+    return ((SubBuckets + sub + 1) << (exponent - 3)) - 1;
+}
+
 ChirpError::Error ChirpTimer::validateConfiguration() const {
 
     ChirpError::Error result = ChirpError::SUCCESS;
@@ -108,9 +304,9 @@ ChirpError::Error ChirpTimer::validateConfiguration() const {
         ChirpLogger::instance("ChirpTimer") << "Cannot configure timer while it is running" << std::endl;
         result = ChirpError::INVALID_SERVICE_STATE;
     }
-    // Validate duration
-    else if (_duration.count() <= 0) {
-        ChirpLogger::instance("ChirpTimer") << "Invalid timer duration: " << _duration.count() << "ms" << std::endl;
+    // Validate duration; absolute timers carry a deadline instead
+    else if (_duration.count() <= 0 && !_hasDeadline) {
+        ChirpLogger::instance("ChirpTimer") << "Invalid timer duration: " << _duration.count() << "ns" << std::endl;
         result = ChirpError::INVALID_ARGUMENTS;
     }
     
@@ -130,6 +326,51 @@ std::string ChirpTimer::getMessage() const {
     return _messageToDeliver;
 }
 
+void ChirpTimer::bindHandler(std::shared_ptr<BoundHandler> handler) {
+
+    std::lock_guard<std::mutex> lock(_configMutex);
+    _boundHandler = std::move(handler);
+    _configGeneration.fetch_add(1, std::memory_order_release);
+}
+
+bool ChirpTimer::firingConfigStale() const {
+
+    return !_firing || _firing->generation != _configGeneration.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const ChirpTimer::FiringConfig> ChirpTimer::captureFiringConfig() {
+
+    auto config = std::make_shared<FiringConfig>();
+    {
+        std::lock_guard<std::mutex> lock(_configMutex);
+        config->generation = _configGeneration.load(std::memory_order_relaxed);
+        config->message = _messageToDeliver;
+        config->mode = _mode;
+        config->period = _duration;
+        config->handler = _boundHandler;
+    }
+
+    if (config->mode == TimerMode::PERIODIC) {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        if (!_latenessHistogram) {
+            _latenessHistogram = std::make_unique<LatenessHistogram>();
+            if (_latenessSamples > 0) {
+                // Only a single sample can have been taken without the histogram
+                _latenessHistogram->counts[LatenessHistogram::bucketOf(_latenessMinNs)]++;
+            }
+        }
+    }
+
+    std::shared_ptr<const FiringConfig> previous = std::move(_firing);
+    _firing = std::move(config);
+    return previous;
+}
+
+std::shared_ptr<const ChirpTimer::FiringConfig> ChirpTimer::releaseFiringConfig() {
+
+    return std::move(_firing);
+}
+
 // Static factory method implementation
 IChirpTimer* IChirpTimer::createTimer() {
     return new ChirpTimer();
@@ -19,6 +19,9 @@
 #include <functional>
 #include <vector>
 #include <any>
+#include <array>
+#include <cstdint>
+#include <memory>
 
 /**
  * @brief Concrete implementation of the IChirpTimer interface
@@ -59,13 +62,117 @@ public:
     // Implementation of IChirpTimer interface
     ChirpError::Error configure(std::string messageToDeliver,
                                const std::chrono::milliseconds& duration) override;
+    ChirpError::Error configure(std::string messageToDeliver,
+                               const std::chrono::nanoseconds& duration,
+                               TimerMode mode) override;
+    ChirpError::Error configureAt(std::string messageToDeliver,
+                                 const std::chrono::steady_clock::time_point& deadline) override;
+    TimerMode getMode() const override;
+    ChirpError::Error setMissedTickPolicy(MissedTickPolicy policy) override;
+    MissedTickPolicy getMissedTickPolicy() const override;
+    uint64_t getMissedTicks() const override;
+    uint64_t getLastMissedTicks() const override;
     ChirpError::Error start() override;
     ChirpError::Error stop() override;
     bool isRunning() const override;
     std::chrono::milliseconds getDuration() const override;
+    std::chrono::nanoseconds getDurationNs() const override;
+    ChirpError::Error setSlack(const std::chrono::nanoseconds& slack) override;
+    std::chrono::nanoseconds getSlack() const override;
+    ChirpError::Error getLatenessStats(TimerLatenessStats& stats) const override;
+    void resetLatenessStats() override;
     std::chrono::steady_clock::time_point getTimerStartTime() const;
     std::string getMessage() const;
 
+    /**
+     * @brief Get the absolute firing time of a timer armed with configureAt()
+     * @param deadline Output parameter for the deadline
+     * @return true if the timer has an absolute deadline
+     */
+    bool getDeadline(std::chrono::steady_clock::time_point& deadline) const;
+
+    /**
+     * @brief Mark a one-shot timer as finished
+     *
+     * Called by the owning loop once the timer has been released.
+     */
+    void expire();
+
+    /**
+     * @brief Record how late the timer was dispatched
+     * @param lateness Time from the scheduled firing time to dispatch
+     *
+     * Called by the owning loop for every firing.
+     */
+    void recordLateness(std::chrono::nanoseconds lateness);
+
+    /**
+     * @brief Account for ticks that were not dispatched
+     * @param missed Ticks dropped or folded into the current dispatch
+     * @param folded true if the ticks are folded into a dispatch that is about to run
+     */
+    void recordMissedTicks(uint64_t missed, bool folded);
+
+    /**
+     * @brief Handler bound to the timer at arm time, with its arguments
+     */
+    using BoundHandler = std::function<void()>;
+
+    /**
+     * @brief Bind a handler that the owning loop calls directly on firing
+     * @param handler The handler, or nullptr to dispatch by message name
+     */
+    void bindHandler(std::shared_ptr<BoundHandler> handler);
+
+    /**
+     * @brief What the owning loop needs to fire the timer, captured when it is armed
+     *
+     * Immutable once captured, so firing reads it without a lock or a copy.
+     */
+    struct FiringConfig {
+        uint64_t generation = 0;
+        std::string message;
+        TimerMode mode = TimerMode::PERIODIC;
+        std::chrono::nanoseconds period{0};
+        std::shared_ptr<BoundHandler> handler;
+    };
+
+    /**
+     * @brief Check whether the timer was configured or bound since the last capture
+     */
+    bool firingConfigStale() const;
+
+    /**
+     * @brief Capture the current configuration for the owning loop
+     * @return The previous capture, which a running handler may still be using
+     *
+     * Periodic timers also get their lateness histogram here, so that no
+     * firing allocates.
+     */
+    std::shared_ptr<const FiringConfig> captureFiringConfig();
+
+    /**
+     * @brief Hand the current capture over to the owning loop
+     * @return The capture; the next arm captures afresh
+     */
+    std::shared_ptr<const FiringConfig> releaseFiringConfig();
+
+    /**
+     * @brief Get the current capture, owning loop only
+     * @return The capture, or nullptr if the timer was not armed
+     */
+    const FiringConfig* firingConfig() const { return _firing.get(); }
+
+    /**
+     * @brief Slot of the timer in the heap of the TimerManager scheduling it
+     *
+     * Kept by TimerManager only, so that finding a timer in the heap costs
+     * no lookup. A timer is scheduled by one manager at a time.
+     */
+    static constexpr size_t NotScheduled = SIZE_MAX;
+    size_t heapSlot() const { return _heapSlot; }
+    void setHeapSlot(size_t slot) { _heapSlot = slot; }
+
 private:
     /**
      * @brief Timer state enumeration
@@ -89,6 +196,39 @@ private:
     mutable std::mutex _configMutex;             /**< Mutex for configuration changes */
     std::atomic<bool> _shouldStop;               /**< Flag to signal timer thread to stop */
     std::string _messageToDeliver;               /**< Message to deliver when timer fires */
-    std::chrono::milliseconds _duration;         /**< Timer duration */ 
+    std::shared_ptr<BoundHandler> _boundHandler; /**< Typed handler called instead of a message lookup */
+    std::chrono::nanoseconds _duration;          /**< Timer duration */ 
     std::chrono::steady_clock::time_point _startTime;  /**< Timer start time */
+    TimerMode _mode = TimerMode::PERIODIC;       /**< Periodic or one-shot */
+    std::atomic<MissedTickPolicy> _missedTickPolicy{MissedTickPolicy::CATCH_UP};  /**< Stall recovery */
+    std::atomic<uint64_t> _missedTicks{0};       /**< Ticks never dispatched */
+    std::atomic<uint64_t> _lastMissedTicks{0};   /**< Ticks folded into the latest dispatch */
+    std::atomic<std::chrono::nanoseconds> _slack{std::chrono::nanoseconds(0)};  /**< Allowed firing delay */
+    bool _hasDeadline = false;                   /**< Armed at an absolute time */
+    std::chrono::steady_clock::time_point _deadline;  /**< Absolute firing time when _hasDeadline */
+    std::atomic<uint64_t> _configGeneration{1};  /**< Bumped by every configure or bind */
+    std::shared_ptr<const FiringConfig> _firing; /**< Owned by the loop the timer is armed on */
+    size_t _heapSlot = NotScheduled;             /**< Owned by the TimerManager scheduling the timer */
+
+    /**
+     * @brief Log-linear histogram of lateness: 8 linear buckets per power of two,
+     *        so a percentile is reported within 1/8 of its true value
+     */
+    struct LatenessHistogram {
+        static constexpr size_t SubBuckets = 8;
+        static constexpr size_t Buckets = SubBuckets * 62;
+        std::array<uint32_t, Buckets> counts{};
+
+        static size_t bucketOf(uint64_t ns);
+        static uint64_t upperBoundOf(size_t bucket);
+    };
+
+    mutable std::mutex _statsMutex;              /**< Guards the lateness statistics */
+    uint64_t _latenessSamples = 0;
+    uint64_t _latenessSumNs = 0;
+    uint64_t _latenessMinNs = 0;
+    uint64_t _latenessMaxNs = 0;
+    // Allocated when a periodic timer is armed, or on the second sample of a
+    // one-shot one, so timers that fire once (timeouts) stay small
+    std::unique_ptr<LatenessHistogram> _latenessHistogram;
 };
@@ -5,7 +5,10 @@
 #include "chirp_watchdog.hpp"
 #include "ichirp.h"
 #include "chirp_factory.h"
+#include "chirp_threads.h"
+#include "chirp_impl.h"
 #include "chirp_logger.h"
+#include "chirp_clock.h"
 
 // IChirpWatchDog constructor implementation
 IChirpWatchDog::IChirpWatchDog(const std::string& name) {}
@@ -26,20 +29,17 @@ ChirpWatchDog::ChirpWatchDog(const std::string& name)
 
 ChirpWatchDog::~ChirpWatchDog() {
  
+    if (_factory) {
+        liftShedding();
+        (void)_factory->removeObserver(this);
+    }
+
     if (_chirpService) {
         _chirpService->shutdown();
         delete _chirpService;
         _chirpService = nullptr;
     }
     
-    // Clean up pet timers
-    for (const auto& kv : _servicePetTimers) {
-        if (kv.second) {
-            delete kv.second;
-        }
-    }
-    _servicePetTimers.clear();
-    
     // Clean up monitor timer
     if (_monitorTimer) {
         delete _monitorTimer;
@@ -58,10 +58,20 @@ ChirpError::Error ChirpWatchDog::configure(IChirpFactory* factory,
     if (!factory || petDuration.count() <= 0) {
         return ChirpError::INVALID_CONFIGURATION;
     }
+    // Start over on reconfiguration; the factory replays its services to us
+    if (_factory) {
+        liftShedding();
+        (void)_factory->removeObserver(this);
+    }
+    clearRegistry();
     _factory = factory;
     _petDuration = petDuration;
     
-    installPetTimers();
+    auto e = _factory->addObserver(this);
+    if (e != ChirpError::SUCCESS) {
+        _factory = nullptr;
+        return e;
+    }
     installMonitorTimer();
     
     return ChirpError::SUCCESS;
@@ -73,24 +83,12 @@ ChirpError::Error ChirpWatchDog::start() {
         return ChirpError::INVALID_SERVICE_STATE;
     }
     
+    // The service may already be running, e.g. started in polled mode by a simulation
     auto e = _chirpService->start();
-    if (e != ChirpError::SUCCESS) {
+    if (e != ChirpError::SUCCESS && e != ChirpError::SERVICE_ALREADY_STARTED) {
         return e;
     }
     
-    // Start all pet timers on their respective services
-    for (auto& kv : _servicePetTimers) {
-        if (kv.second) {
-            kv.second->start();
-            
-            // Now add to service AFTER it's started (so it's marked as RUNNING)
-            IChirp* svc = _factory->getService(kv.first);
-            if (svc) {
-                svc->addChirpTimer(kv.second);
-            }
-        }
-    }
-    
     if (_monitorTimer) {
         _monitorTimer->start();
         
@@ -106,69 +104,149 @@ ChirpError::Error ChirpWatchDog::stop() {
     if (!_chirpService) 
         return ChirpError::INVALID_SERVICE_STATE;
     
-    for (auto& [name, timer] : _servicePetTimers) {
-        if (timer) {
-            timer->stop();
-        }
-    }
-
     if (_monitorTimer) {
         _monitorTimer->stop();
         _chirpService->removeChirpTimer(_monitorTimer);
     }
-    
-    uninstallPetTimers();
+    liftShedding();
     
     return _chirpService->shutdown();
 }
 
-void ChirpWatchDog::installPetTimers() {
+ChirpError::Error ChirpWatchDog::setHealthThresholds(const std::string& serviceName,
+                                                     const std::chrono::nanoseconds& p99Sojourn,
+                                                     size_t maxQueueDepth) {
 
-    if (!_factory) {
-        return;
+    if (serviceName.empty() || p99Sojourn.count() < 0) {
+        return ChirpError::INVALID_ARGUMENTS;
     }
-    
-    uninstallPetTimers();
-    
-    std::vector<std::string> serviceNames = _factory->listServiceNames();
-    
-    for (const auto& name : serviceNames) {
-        IChirp* svc = _factory->getService(name);
-        
-        if (!svc || !svc->getWatchDogMonitoring()) {
-            continue;
-        }
 
-        if (_servicePetTimers.find(name) == _servicePetTimers.end()) {
-            std::string timerMsgName = "_PetTimer_" + name;
-            auto timer = new ChirpTimer(timerMsgName, _petDuration);
-            if (timer) {
-                _servicePetTimers[name] = timer;
-                // Timer will be added to service in start() after it's started
-                
-                // Register a handler on the watched service for this timer
-                (void)svc->registerMsgHandler(timerMsgName, 
-                                             this, 
-                                             &ChirpWatchDog::onPetTimerFired);
-            }
-        }
+    HealthThresholds thresholds{p99Sojourn, maxQueueDepth};
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    // DROP_STALE sheds against the sojourn threshold, so it cannot go without one
+    auto shedding = _sheddingPolicies.find(serviceName);
+    if (shedding != _sheddingPolicies.end() && shedding->second == IChirp::SheddingPolicy::DROP_STALE &&
+        p99Sojourn.count() == 0 && maxQueueDepth > 0) {
+        return ChirpError::INVALID_CONFIGURATION;
+    }
+    if (p99Sojourn.count() == 0 && maxQueueDepth == 0) {
+        _healthThresholds.erase(serviceName);
+    } else {
+        _healthThresholds[serviceName] = thresholds;
+    }
+
+    auto it = std::find(_slotNames.begin(), _slotNames.end(), serviceName);
+    if (it != _slotNames.end()) {
+        size_t slot = static_cast<size_t>(it - _slotNames.begin());
+        _slotHealth[slot] = thresholds;
+        _slotLastStats[slot] = ChirpQueueStats{};
     }
+    return ChirpError::SUCCESS;
 }
 
-void ChirpWatchDog::uninstallPetTimers() {
+ChirpError::Error ChirpWatchDog::setLoadShedding(const std::string& serviceName,
+                                                 IChirp::SheddingPolicy policy) {
 
-    for (auto& kv : _servicePetTimers) {
-        const std::string& name = kv.first;
-        if (_factory) {
-            IChirp* svc = _factory->getService(name);
-            if (svc && kv.second) {
-                kv.second->stop();
-                svc->removeChirpTimer(kv.second);
-                delete kv.second;
-            }
+    if (serviceName.empty()) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    auto thresholds = _healthThresholds.find(serviceName);
+    if (policy == IChirp::SheddingPolicy::DROP_STALE && thresholds != _healthThresholds.end() &&
+        thresholds->second.p99Sojourn.count() == 0) {
+        return ChirpError::INVALID_CONFIGURATION;
+    }
+    if (policy == IChirp::SheddingPolicy::NONE) {
+        _sheddingPolicies.erase(serviceName);
+    } else {
+        _sheddingPolicies[serviceName] = policy;
+    }
+
+    auto it = std::find(_slotNames.begin(), _slotNames.end(), serviceName);
+    if (it != _slotNames.end()) {
+        size_t slot = static_cast<size_t>(it - _slotNames.begin());
+        // A policy change takes effect at the next degraded tick
+        if (_slotShedding[slot].active) {
+            (void)_slotServices[slot]->setLoadShedding(IChirp::SheddingPolicy::NONE);
         }
+        _slotShedding[slot] = Shedding{policy};
+    }
+    return ChirpError::SUCCESS;
+}
+
+void ChirpWatchDog::onServiceCreated(const std::string& serviceName, IChirp* service) {
+
+    if (!service || !service->_impl) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    if (_slotIndex.count(service)) {
+        return;
     }
-    _servicePetTimers.clear();
+
+    // Holding the heartbeat keeps it readable even after the service is deleted
+    auto heartbeat = service->_impl->getHeartbeat();
+    auto health = _healthThresholds.find(serviceName);
+    auto shedding = _sheddingPolicies.find(serviceName);
+
+    _slotIndex[service] = _slotServices.size();
+    _slotServices.push_back(service);
+    _slotNames.push_back(serviceName);
+    _slotLastIterations.push_back(heartbeat->iterations.load(std::memory_order_relaxed));
+    _slotProgressNs.push_back(0);
+    _slotHeartbeats.push_back(std::move(heartbeat));
+    _slotHealth.push_back(health != _healthThresholds.end() ? health->second : HealthThresholds{});
+    _slotLastStats.emplace_back();
+    _slotShedding.push_back(Shedding{shedding != _sheddingPolicies.end() ? shedding->second : IChirp::SheddingPolicy::NONE});
+}
+
+void ChirpWatchDog::onServiceDestroyed(const std::string& /*serviceName*/, IChirp* service) {
+
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    auto it = _slotIndex.find(service);
+    if (it == _slotIndex.end()) {
+        return;
+    }
+
+    // Move the last slot into the freed one so the vectors stay dense
+    size_t slot = it->second;
+    size_t last = _slotServices.size() - 1;
+    _slotIndex.erase(it);
+    if (slot != last) {
+        _slotServices[slot] = _slotServices[last];
+        _slotNames[slot] = std::move(_slotNames[last]);
+        _slotHeartbeats[slot] = std::move(_slotHeartbeats[last]);
+        _slotLastIterations[slot] = _slotLastIterations[last];
+        _slotProgressNs[slot] = _slotProgressNs[last];
+        _slotHealth[slot] = _slotHealth[last];
+        _slotLastStats[slot] = _slotLastStats[last];
+        _slotShedding[slot] = _slotShedding[last];
+        _slotIndex[_slotServices[slot]] = slot;
+    }
+    _slotServices.pop_back();
+    _slotNames.pop_back();
+    _slotHeartbeats.pop_back();
+    _slotLastIterations.pop_back();
+    _slotProgressNs.pop_back();
+    _slotHealth.pop_back();
+    _slotLastStats.pop_back();
+    _slotShedding.pop_back();
+}
+
+void ChirpWatchDog::clearRegistry() {
+
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    _slotServices.clear();
+    _slotNames.clear();
+    _slotHeartbeats.clear();
+    _slotLastIterations.clear();
+    _slotProgressNs.clear();
+    _slotHealth.clear();
+    _slotLastStats.clear();
+    _slotShedding.clear();
+    _slotIndex.clear();
 }
 
 void ChirpWatchDog::installMonitorTimer() {
@@ -181,54 +259,126 @@ void ChirpWatchDog::installMonitorTimer() {
     _monitorTimer = new ChirpTimer("monitorTimerElapsed", 2 * _petDuration);
 }
 
-ChirpError::Error ChirpWatchDog::onPetTimerFired(const std::string& timerMsgName) {
+ChirpError::Error ChirpWatchDog::onMonitorTick(const std::string& timerMessage) {
     
-    std::string servicePrefix = "_PetTimer_";
-    if (timerMsgName.substr(0, servicePrefix.length()) != servicePrefix) {
-        return ChirpError::INVALID_ARGUMENTS;
+    if (!_factory) {
+        return ChirpError::INVALID_SERVICE_STATE;
     }
     
-    std::string serviceName = timerMsgName.substr(servicePrefix.length());
-    
-    // Record that the service was "petted" (timer fired, meaning service is responsive)
-    std::lock_guard<std::mutex> lock(_petMutex);
-    _lastPetTime[serviceName] = std::chrono::steady_clock::now();
-    
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      ChirpClock::now().time_since_epoch()).count();
+    int64_t threshold = std::chrono::duration_cast<std::chrono::nanoseconds>(2.1 * _petDuration).count();
+
+    // A service has missed its pet when it has been busy without completing a
+    // loop iteration for longer than the threshold. Waiting for work is not a miss.
+    std::lock_guard<std::mutex> lock(_registryMutex);
+
+    for (size_t i = 0; i < _slotHeartbeats.size(); ++i) {
+        if (_slotHealth[i].p99Sojourn.count() > 0 || _slotHealth[i].maxQueueDepth > 0) {
+            checkHealth(i);
+        }
+
+        const ChirpHeartbeat& heartbeat = *_slotHeartbeats[i];
+        if (!heartbeat.monitored.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        uint64_t iterations = heartbeat.iterations.load(std::memory_order_relaxed);
+        if (iterations != _slotLastIterations[i]) {
+            _slotLastIterations[i] = iterations;
+            _slotProgressNs[i] = now;
+            continue;
+        }
+
+        int64_t busySince = heartbeat.busySinceNs.load(std::memory_order_relaxed);
+        if (busySince == 0) {
+            continue;
+        }
+        if (now - std::max(busySince, _slotProgressNs[i]) <= threshold) {
+            continue;
+        }
+        (void)_chirpService->postMsg(IChirpWatchDog::MissedPetMessage, _slotNames[i]);
+
+        std::string handler;
+        int64_t handlerSince = 0;
+        if (heartbeat.currentHandler(handler, handlerSince)) {
+            std::chrono::nanoseconds running(now - handlerSince);
+            ChirpLogger::instance(_slotNames[i]) << "Handler " << handler << " stuck for "
+                                                 << running.count() << "ns" << std::endl;
+            (void)_chirpService->postMsg(IChirpWatchDog::StuckHandlerMessage, _slotNames[i], handler, running);
+        }
+    }
+
     return ChirpError::SUCCESS;
 }
 
-ChirpError::Error ChirpWatchDog::onMonitorTick(const std::string& timerMessage) {
-    
-    if (!_factory) {
-        return ChirpError::INVALID_SERVICE_STATE;
+void ChirpWatchDog::checkHealth(size_t slot) {
+
+    // Judge the last monitor period only, so a service recovers once its backlog is gone
+    ChirpQueueStats stats;
+    if (_slotServices[slot]->getQueueStats(stats) != ChirpError::SUCCESS) {
+        return;
     }
-    
-    auto now = std::chrono::steady_clock::now();
+    ChirpQueueStats& previous = _slotLastStats[slot];
+    auto p99 = stats.sojournPercentile(0.99, &previous);
+    previous = stats;
 
-    // Get all monitored services and check for missed pets
-    std::vector<std::string> serviceNames = _factory->listServiceNames();
-    
-    std::lock_guard<std::mutex> lock(_petMutex);
-        
-    for (const auto& serviceName : serviceNames) {
-        IChirp* svc = _factory->getService(serviceName);
-        if (svc && svc->getWatchDogMonitoring()) {
-            auto it = _lastPetTime.find(serviceName);
-            if (it == _lastPetTime.end()) {
-                _lastPetTime[serviceName] = now;
+    const HealthThresholds& thresholds = _slotHealth[slot];
+    bool slow = thresholds.p99Sojourn.count() > 0 && p99 > thresholds.p99Sojourn;
+    bool backlogged = thresholds.maxQueueDepth > 0 && stats.queueDepth > thresholds.maxQueueDepth;
+    if (slow || backlogged) {
+        ChirpLogger::instance(_slotNames[slot]) << "Degraded: p99 sojourn " << p99.count()
+                                                << "ns, queue depth " << stats.queueDepth << std::endl;
+        (void)_chirpService->postMsg(IChirpWatchDog::DegradedMessage, _slotNames[slot]);
+    }
+
+    // Recovering takes going well under the thresholds, not just back below them
+    bool recovered = (thresholds.p99Sojourn.count() == 0 || p99 <= thresholds.p99Sojourn / 2) &&
+                     (thresholds.maxQueueDepth == 0 || stats.queueDepth <= thresholds.maxQueueDepth / 2);
+    applyShedding(slot, slow || backlogged, recovered);
+}
+
+void ChirpWatchDog::applyShedding(size_t slot, bool degraded, bool recovered) {
+
+    Shedding& shedding = _slotShedding[slot];
+    if (shedding.policy == IChirp::SheddingPolicy::NONE) {
+        return;
+    }
+
+    if (degraded) {
+        shedding.healthyTicks = 0;
+        if (!shedding.active) {
+            auto e = _slotServices[slot]->setLoadShedding(shedding.policy, _slotHealth[slot].p99Sojourn);
+            if (e == ChirpError::SUCCESS) {
+                shedding.active = true;
             } else {
-                // Check if service missed its petting
-                auto timeSinceLastPet = now - it->second;
-                auto threshold = 2.1 * _petDuration;  // Threshold is 2 * pet duration
-                    
-                if (timeSinceLastPet > threshold) {
-                    (void)_chirpService->postMsg(IChirpWatchDog::MissedPetMessage, serviceName);
-                } 
+                ChirpLogger::instance(_slotNames[slot]) << "Cannot shed load: "
+                                                        << ChirpError::errorToString(e) << std::endl;
             }
         }
+        return;
+    }
+
+    if (!shedding.active) {
+        return;
+    }
+    shedding.healthyTicks = recovered ? shedding.healthyTicks + 1 : 0;
+    if (shedding.healthyTicks >= RecoveryTicks) {
+        (void)_slotServices[slot]->setLoadShedding(IChirp::SheddingPolicy::NONE);
+        shedding.active = false;
+        shedding.healthyTicks = 0;
     }
-    return ChirpError::SUCCESS;
 }
 
+void ChirpWatchDog::liftShedding() {
 
+    std::lock_guard<std::mutex> lock(_registryMutex);
+    for (size_t slot = 0; slot < _slotShedding.size(); ++slot) {
+        if (_slotShedding[slot].active) {
+            (void)_slotServices[slot]->setLoadShedding(IChirp::SheddingPolicy::NONE);
+            _slotShedding[slot].active = false;
+            _slotShedding[slot].healthyTicks = 0;
+        }
+    }
+}
 
@@ -3,13 +3,16 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 
 #include "ichirp_watchdog.h"
+#include "ichirp.h"
 #include "chirp_timer.h"
+#include "chirp_heartbeat.h"
 
-class ChirpWatchDog : public IChirpWatchDog {
+class ChirpWatchDog : public IChirpWatchDog, private IChirpFactoryObserver {
 
 public:
     explicit ChirpWatchDog(const std::string& name);
@@ -19,22 +22,56 @@ public:
                                 const std::chrono::milliseconds& petDuration) override;
     ChirpError::Error start() override;
     ChirpError::Error stop() override;
+    ChirpError::Error setHealthThresholds(const std::string& serviceName,
+                                          const std::chrono::nanoseconds& p99Sojourn,
+                                          size_t maxQueueDepth) override;
+    ChirpError::Error setLoadShedding(const std::string& serviceName,
+                                      IChirp::SheddingPolicy policy) override;
     
     // Getter for the internal Chirp service
     IChirp* getChirpService() override;
 
 private:
 
-    void installPetTimers();
-    void uninstallPetTimers();
+    // IChirpFactoryObserver: keeps the registry below in step with the factory
+    void onServiceCreated(const std::string& serviceName, IChirp* service) override;
+    void onServiceDestroyed(const std::string& serviceName, IChirp* service) override;
+
     void installMonitorTimer();
-    ChirpError::Error onPetTimerFired(const std::string& serviceName);
     ChirpError::Error onMonitorTick(const std::string& timerMessage);
-    
-    // Pet handler members (for storing last pet times)
-    std::map<std::string, std::chrono::steady_clock::time_point> _lastPetTime;
-    std::mutex _petMutex;
-    const std::map<std::string, std::chrono::steady_clock::time_point>& getLastPetTimes() const { return _lastPetTime; }
+    void checkHealth(size_t slot);
+    void applyShedding(size_t slot, bool degraded, bool recovered);
+    void liftShedding();
+    void clearRegistry();
+
+    struct HealthThresholds {
+        std::chrono::nanoseconds p99Sojourn{0};
+        size_t maxQueueDepth = 0;
+    };
+
+    // Registry of every service of the factory. A service's slot is its index
+    // in all the vectors; a destroyed service's slot is filled by the last one.
+    // A monitor tick walks the vectors in order and touches no name or factory
+    // lock unless it has something to report.
+    std::vector<IChirp*> _slotServices;
+    std::vector<std::string> _slotNames;
+    std::vector<std::shared_ptr<const ChirpHeartbeat>> _slotHeartbeats;
+    std::vector<uint64_t> _slotLastIterations;
+    std::vector<int64_t> _slotProgressNs;     // When the counter was last seen moving
+    std::vector<HealthThresholds> _slotHealth;
+    std::vector<ChirpQueueStats> _slotLastStats;  // Snapshot the service was last judged against
+    struct Shedding {
+        IChirp::SheddingPolicy policy = IChirp::SheddingPolicy::NONE;
+        bool active = false;        // The watchdog applied policy to the service
+        unsigned healthyTicks = 0;  // Consecutive periods under the recovery marks
+    };
+    std::vector<Shedding> _slotShedding;
+    std::unordered_map<IChirp*, size_t> _slotIndex;
+    std::mutex _registryMutex;
+
+    // Queue health thresholds and shedding policies by name, also for services not created yet
+    std::map<std::string, HealthThresholds> _healthThresholds;
+    std::map<std::string, IChirp::SheddingPolicy> _sheddingPolicies;
 
     // Internal Chirp service instance
     IChirp* _chirpService = nullptr;
@@ -42,8 +79,6 @@ private:
     IChirpFactory* _factory = nullptr;
     std::chrono::milliseconds _petDuration{0};
 
-    std::map<std::string, ChirpTimer*> _servicePetTimers;
-
     ChirpTimer* _monitorTimer = nullptr;
 };
 
@@ -29,4 +29,44 @@ void Message::sync_notify() {
         _sync_done = true;
     }
     _sync_cv.notify_one();
-}
\ No newline at end of file
+}
+
+void Message::setExpiry(std::chrono::steady_clock::time_point expiry) {
+    _expiry = expiry;
+}
+
+bool Message::hasExpiry() const {
+    return _expiry != std::chrono::steady_clock::time_point{};
+}
+
+std::chrono::steady_clock::time_point Message::getExpiry() const {
+    return _expiry;
+}
+
+void Message::setDueTime(std::chrono::steady_clock::time_point due) {
+    _due = due;
+}
+
+std::chrono::steady_clock::time_point Message::getDueTime() const {
+    return _due;
+}
+
+void Message::setDeadline(std::chrono::steady_clock::time_point deadline) {
+    _deadline = deadline;
+}
+
+bool Message::hasDeadline() const {
+    return _deadline != std::chrono::steady_clock::time_point{};
+}
+
+std::chrono::steady_clock::time_point Message::getDeadline() const {
+    return _deadline;
+}
+
+void Message::setEnqueueTime(std::chrono::steady_clock::time_point enqueued) {
+    _enqueued = enqueued;
+}
+
+std::chrono::steady_clock::time_point Message::getEnqueueTime() const {
+    return _enqueued;
+}
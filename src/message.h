@@ -8,8 +8,12 @@
 #include <vector>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
 
-class Message {
+#include "mpsc_queue.h"
+
+// The link is used while a deferred message waits to be handed to its loop
+class Message : public MpscNode {
 
 public:
     enum class MessageType {
@@ -28,6 +32,25 @@ public:
     void sync_wait();
     void sync_notify();
 
+    // Async messages may carry a point after which dispatching them is pointless
+    void setExpiry(std::chrono::steady_clock::time_point expiry);
+    bool hasExpiry() const;
+    std::chrono::steady_clock::time_point getExpiry() const;
+
+    // Point by which the handler should have finished; orders the queue
+    // under earliest-deadline-first scheduling
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    bool hasDeadline() const;
+    std::chrono::steady_clock::time_point getDeadline() const;
+
+    // Time the message joined the run queue, for sojourn statistics
+    void setEnqueueTime(std::chrono::steady_clock::time_point enqueued);
+    std::chrono::steady_clock::time_point getEnqueueTime() const;
+
+    // Deferred messages are held back by the loop until this point
+    void setDueTime(std::chrono::steady_clock::time_point due);
+    std::chrono::steady_clock::time_point getDueTime() const;
+
 private:
     std::string _msg;
     std::vector<std::any> _args;
@@ -35,4 +58,8 @@ private:
     std::mutex _sync_mtx;
     std::condition_variable _sync_cv;
     bool _sync_done;
+    std::chrono::steady_clock::time_point _expiry{};  // Default constructed: never expires
+    std::chrono::steady_clock::time_point _due{};
+    std::chrono::steady_clock::time_point _deadline{};  // Default constructed: no deadline
+    std::chrono::steady_clock::time_point _enqueued{};
 };
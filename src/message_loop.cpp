@@ -2,46 +2,357 @@
 // Created by manoj ij thadani on 7/9/25.
 //
 #include <iostream>
-#include <bits/ostream.tcc>
+#include <algorithm>
 #include <thread>
 #include <chrono>
+#include <cerrno>
+#include <cstdint>
+#include <bit>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/prctl.h>
 
 #include "message_loop.h"
 #include "chirp_logger.h"
 #include "message.h"
 #include "chirp_timer.h"
+#include "ichirp.h"
+#include "chirp_clock.h"
+#include "shared_timer_thread.h"
+
+MessageLoop::MessageLoop() {
+
+    openWakeupFds();
+}
+
+MessageLoop::~MessageLoop() {
+
+    // Adds that were never applied still own their command
+    while (MpscNode* node = _timer_cmds.pop()) {
+        TimerCommand* cmd = static_cast<TimerCommand*>(node);
+        if (cmd->op == TimerCommand::Op::ADD) {
+            delete cmd;
+        }
+    }
+    SharedTimerThread::instance().detach(this);
+    dropDeferredMessages();
+    closeWakeupFds();
+}
 
 void MessageLoop::spin() {
 
-    bool lockAcquired = false;
     bool st_thread = false;
-    setStopThread(st_thread);
 
-    _empty_mtx.lock();
-    while (!st_thread) {
+    // The kernel delays timerfd expiries by the thread's timer slack (50us by
+    // default) to batch wakeups. Loop threads need sub-millisecond timers to
+    // fire on time, so ask for the minimum.
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
 
-          // Get duration to next timer event
-        std::chrono::milliseconds duration = _timer_mgr.getDurationToNextTimerEvent();
+    // The spinning thread owns the timer schedule until it exits
+    std::lock_guard<std::mutex> owner(_loop_mtx);
+    _loop_thread = std::this_thread::get_id();
+    _heartbeat->markBusy();
 
-        if ((duration.count() == 0) && (_message_queue.empty())) {
+    while (!st_thread) {
 
-            ChirpLogger::instance(_service_name) << "waiting. MsgQ empty." << std::endl;
-            // No timers or timer already elapsed, just wait on mutex
-            _empty_mtx.lock();
-        }
-        if ((duration.count() > 0) && (_message_queue.empty())) {
+        _heartbeat->beat();
+        if (!hasPendingMessages()) {
 
-            // Wait on mutex with timeout
-            lockAcquired = _empty_mtx.try_lock_for(duration);
+            ChirpLogger::instance(_service_name) << "waiting. MsgQ empty." << std::endl;
+            // Sleep until a message is posted or the next timer is due.
+            // armWakeup() re-checks the queue so a concurrent post is never lost.
+            armWakeup();
+            bool released = false;
+            if (_wake_armed) {
+                armTimerFd();
+                int idleMs = idleWaitMs();
+                auto waitStart = std::chrono::steady_clock::now();
+                _heartbeat->markIdle();
+                waitForEvents(idleMs);
+                _heartbeat->markBusy();
+                _wakeups.fetch_add(1, std::memory_order_relaxed);
+                released = idleMs >= 0 &&
+                           std::chrono::steady_clock::now() - waitStart >= std::chrono::milliseconds(idleMs) &&
+                           _release();
+            }
+            _wake_armed = false;
+            clearEvents();
+            if (released) {
+                // Dormant: the next post spawns a new thread
+                break;
+            }
+        } else if (_fd_watch_count > 0) {
+            // Busy with messages: still give ready descriptors their turn
+            harvestFdEvents();
         }
 
+        applyTimerCommands();
+        releaseDeferredMessages();
         fireTimerHandlers(st_thread);
+        fireFdHandlers(st_thread);
         fireRegularHandlers(st_thread);
-    }   
-     
+    }
+
+    _heartbeat->markIdle();
+    _loop_thread = std::thread::id();
     ChirpLogger::instance(_service_name) << "Spin loop stopped." << std::endl;
 }
 
+void MessageLoop::setActivation(std::function<void()> activate, std::function<bool()> release) {
+
+    _activate = std::move(activate);
+    _release = std::move(release);
+}
+
+void MessageLoop::setIdleTimeout(const std::chrono::milliseconds& timeout) {
+
+    _idle_timeout_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+    // A loop already waiting without a timeout picks the new one up on its next wait
+    signal();
+}
+
+void MessageLoop::setDormant(bool dormant) {
+
+    _dormant.store(dormant);
+}
+
+void MessageLoop::countActivation() {
+
+    _activations.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool MessageLoop::isDormant() const {
+
+    return _dormant.load();
+}
+
+bool MessageLoop::hasWork() {
+
+    return hasPendingMessages() || _pending_timer_cmds.load() > 0 || _stop_thread ||
+           _timer_mgr.getTimerCount() > 0 || _timer_mgr.getDeferredMessageCount() > 0 ||
+           _fd_watch_count > 0;
+}
+
+void MessageLoop::wakeIfDormant() {
+
+    // Called after the work is published; see ChirpThread::releaseThread()
+    if (_dormant.load() && _activate) {
+        _activate();
+    }
+}
+
+int MessageLoop::idleWaitMs() {
+
+    // Only a loop with nothing scheduled or watched may go dormant
+    int64_t ns = _idle_timeout_ns.load(std::memory_order_relaxed);
+    if (ns <= 0 || !_release || _timer_mgr.getTimerCount() > 0 ||
+        _timer_mgr.getDeferredMessageCount() > 0 || _fd_watch_count > 0) {
+        return -1;
+    }
+    return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(std::chrono::nanoseconds(ns)).count());
+}
+
+void MessageLoop::prepare() {
+
+    setStopThread(false);
+    _shared_timers = SharedTimerThread::instance().attach(this);
+    _armed_deadline = std::chrono::steady_clock::time_point{};
+    armWakeup();
+    armTimerFd();
+}
+
+size_t MessageLoop::poll(size_t budget) {
+
+    bool st_thread = false;
+    size_t dispatched = 0;
+    _wakeups.fetch_add(1, std::memory_order_relaxed);
+
+    // The polling thread owns the timer schedule for the duration of the call
+    std::lock_guard<std::mutex> owner(_loop_mtx);
+    _loop_thread = std::this_thread::get_id();
+    _heartbeat->markBusy();
+
+    // Consume the readiness that brought the caller here. Anything posted
+    // from now on re-signals the descriptor once _wake_armed is set again.
+    _wake_armed = false;
+    clearEvents();
+    if (_fd_watch_count > 0) {
+        harvestFdEvents();
+    }
+
+    applyTimerCommands();
+    releaseDeferredMessages();
+    dispatched += fireTimerHandlers(st_thread);
+    dispatched += fireFdHandlers(st_thread);
+    while (!st_thread && dispatched < budget) {
+        size_t fired = fireRegularHandlers(st_thread);
+        if (fired == 0) {
+            break;
+        }
+        dispatched += fired;
+    }
+
+    // Leave the descriptor readable if work is left over, otherwise arm it
+    // for the next post and for the next timer deadline.
+    armWakeup();
+    if (!_wake_armed) {
+        signal();
+    }
+    armTimerFd();
+    _heartbeat->beat();
+    _heartbeat->markIdle();
+    _loop_thread = std::thread::id();
+    return dispatched;
+}
+
+size_t MessageLoop::runFor(const std::chrono::milliseconds& duration) {
+
+    size_t dispatched = 0;
+    auto deadline = std::chrono::steady_clock::now() + duration;
+
+    while (!_stop_thread) {
+        dispatched += poll(SIZE_MAX);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+        waitForEvents(static_cast<int>(remaining.count()));
+    }
+    return dispatched;
+}
+
+bool MessageLoop::getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const {
+
+    // Called by whoever drives a polled loop, between poll() calls
+    std::lock_guard<std::mutex> owner(_loop_mtx);
+    return _timer_mgr.getNextTimerFiringTime(deadline);
+}
+
+void MessageLoop::getServiceStats(ChirpServiceStats& stats) const {
+
+    stats.wakeups = _wakeups.load(std::memory_order_relaxed);
+    stats.timerBatches = _timer_batches.load(std::memory_order_relaxed);
+    stats.timersFired = _timers_fired.load(std::memory_order_relaxed);
+    stats.messagesExpired = _messages_expired.load(std::memory_order_relaxed);
+    stats.deadlineMessages = _deadline_messages.load(std::memory_order_relaxed);
+    stats.deadlineMisses = _deadline_misses.load(std::memory_order_relaxed);
+    stats.messagesShed = _messages_shed.load(std::memory_order_relaxed);
+    stats.activations = _activations.load(std::memory_order_relaxed);
+}
+
+void MessageLoop::getQueueStats(ChirpQueueStats& stats) const {
+
+    uint64_t dequeued = 0;
+    for (size_t i = 0; i < ChirpQueueStats::SojournBuckets; ++i) {
+        stats.sojourn[i] = _sojourn[i].load(std::memory_order_relaxed);
+        dequeued += stats.sojourn[i];
+    }
+    // Derived from the buckets so the snapshot is self-consistent
+    stats.dequeued = dequeued;
+
+    std::lock_guard<std::mutex> lock(_queue_mtx);
+    stats.queueDepth = _message_queue.size() + _deadline_queue.size();
+}
+
+std::shared_ptr<const ChirpHeartbeat> MessageLoop::getHeartbeat() const {
+
+    return _heartbeat;
+}
+
+void MessageLoop::setWatchDogMonitoring(bool enabled) {
+
+    _heartbeat->monitored.store(enabled, std::memory_order_relaxed);
+}
+
+void MessageLoop::sharedTimerDue() {
+
+    // Always write the eventfd: even a busy loop must notice that its
+    // registered deadline is gone, or it would never register the next one
+    _shared_timer_fired = true;
+    signal();
+}
+
+void MessageLoop::getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const {
+
+    std::lock_guard<std::mutex> lock(_expired_mtx);
+    counts = _expired_counts;
+}
+
+void MessageLoop::setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold) {
+
+    _slow_handler_ns.store(threshold.count(), std::memory_order_relaxed);
+}
+
+void MessageLoop::getSlowHandlers(std::vector<ChirpSlowHandler>& log) const {
+
+    std::lock_guard<std::mutex> lock(_slow_mtx);
+    log.assign(_slow_handlers.begin(), _slow_handlers.end());
+}
+
+void MessageLoop::setSchedulingPolicy(IChirp::SchedulingPolicy policy) {
+
+    std::lock_guard<std::mutex> lock(_queue_mtx);
+    if (policy == _policy) {
+        return;
+    }
+
+    // Re-queue whatever is waiting under the new policy, in posting order
+    std::vector<Message*> queued;
+    if (_policy == IChirp::SchedulingPolicy::FIFO) {
+        queued.assign(_message_queue.begin(), _message_queue.end());
+        _message_queue.clear();
+    } else {
+        std::sort(_deadline_queue.begin(), _deadline_queue.end(),
+                  [](const DeadlineEntry& a, const DeadlineEntry& b) { return a.sequence < b.sequence; });
+        for (const DeadlineEntry& entry : _deadline_queue) {
+            queued.push_back(entry.message);
+        }
+        _deadline_queue.clear();
+    }
+
+    _policy = policy;
+    for (Message* m : queued) {
+        pushLocked(m, EnqueuePosition::ENQUEUE_BACK);
+    }
+}
+
+void MessageLoop::setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn) {
+
+    _shed_sojourn_ns.store(maxSojourn.count(), std::memory_order_relaxed);
+    if (_shedding.exchange(policy) != policy) {
+        ChirpLogger::instance(_service_name) << "Load shedding policy set to " << static_cast<int>(policy) << std::endl;
+    }
+}
+
+IChirp::SheddingPolicy MessageLoop::getLoadShedding() const {
+
+    return _shedding.load(std::memory_order_relaxed);
+}
+
+bool MessageLoop::admitPost() {
+
+    if (_shedding.load(std::memory_order_relaxed) != IChirp::SheddingPolicy::REJECT_NEW) {
+        return true;
+    }
+    _messages_shed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+IChirp::SchedulingPolicy MessageLoop::getSchedulingPolicy() const {
+
+    std::lock_guard<std::mutex> lock(_queue_mtx);
+    return _policy;
+}
+
+int MessageLoop::getPollFd() const {
+
+    return _poll_fd;
+}
+
 void MessageLoop::enqueue(Message* m) {
 
     enqueueInternal(m, Message::MessageType::ASYNC);
@@ -53,31 +364,108 @@ void MessageLoop::enqueueSync(Message* m) {
 }
 
 void MessageLoop::enqueueInternal(Message* m, Message::MessageType type, EnqueuePosition position) {
-    
+
     if (!_stop_thread) {
 
         std::string msg;
         m->getMessage(msg);
         ChirpLogger::instance(_service_name) << "Enqueing message " << msg << std::endl;
-        
-        (position == EnqueuePosition::ENQUEUE_FRONT) ? _message_queue.push_front(m)  
-                                                     : _message_queue.push_back(m);
-        
-        if (!_message_queue.empty()) {
-            _empty_mtx.unlock();
+
+        {
+            std::lock_guard<std::mutex> lock(_queue_mtx);
+            pushLocked(m, position);
         }
+        notify();
+        wakeIfDormant();
+
         if (type == Message::MessageType::SYNC) {
+            // Once notified the message is ours; the loop no longer touches it
             m->sync_wait();
+            delete m;
+        }
+    }
+}
+
+void MessageLoop::enqueueDeferred(Message* m, std::chrono::steady_clock::time_point due) {
+
+    if (_stop_thread) {
+        delete m;
+        return;
+    }
+
+    // Same path as a timer add, minus the command: the message is its own
+    // queue node, so a deferred post costs no more than a regular one
+    m->setDueTime(due);
+    _deferred_msgs.push(m);
+    _pending_timer_cmds.fetch_add(1);
+    applyOrWakeLoop();
+}
+
+bool MessageLoop::hasPendingMessages() {
+
+    std::lock_guard<std::mutex> lock(_queue_mtx);
+    return !queueEmptyLocked();
+}
+
+void MessageLoop::pushLocked(Message* m, EnqueuePosition position) {
+
+    auto now = ChirpClock::now();
+    m->setEnqueueTime(now);
+
+    if (_policy == IChirp::SchedulingPolicy::FIFO) {
+        (position == EnqueuePosition::ENQUEUE_FRONT) ? _message_queue.push_front(m)
+                                                     : _message_queue.push_back(m);
+        return;
+    }
+
+    // A message without a deadline is due when it is posted, so work with a
+    // distant deadline cannot hold it back indefinitely
+    std::chrono::steady_clock::time_point deadline;
+    if (position == EnqueuePosition::ENQUEUE_FRONT) {
+        deadline = std::chrono::steady_clock::time_point::min();
+    } else {
+        deadline = m->hasDeadline() ? m->getDeadline() : now;
+    }
+    _deadline_queue.push_back(DeadlineEntry{deadline, _queue_sequence++, m});
+    std::push_heap(_deadline_queue.begin(), _deadline_queue.end(), dispatchedAfter);
+}
+
+Message* MessageLoop::popLocked() {
+
+    Message* m = nullptr;
+    if (_policy == IChirp::SchedulingPolicy::FIFO) {
+        if (!_message_queue.empty()) {
+            m = _message_queue.front();
+            _message_queue.pop_front();
         }
+    } else if (!_deadline_queue.empty()) {
+        std::pop_heap(_deadline_queue.begin(), _deadline_queue.end(), dispatchedAfter);
+        m = _deadline_queue.back().message;
+        _deadline_queue.pop_back();
     }
+    return m;
+}
+
+bool MessageLoop::queueEmptyLocked() const {
+
+    return _message_queue.empty() && _deadline_queue.empty();
+}
+
+bool MessageLoop::dispatchedAfter(const DeadlineEntry& a, const DeadlineEntry& b) {
+
+    // std::push_heap builds a max-heap, so order by "dispatched later"
+    if (a.deadline != b.deadline) {
+        return a.deadline > b.deadline;
+    }
+    return a.sequence > b.sequence;
 }
 
 void MessageLoop::setServiceName(const std::string& service_name) {
-    
+
     _service_name = service_name;
 }
 
-void MessageLoop::getCbMap(std::map<std::string, 
+void MessageLoop::getCbMap(std::map<std::string,
                            std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap) {
     funcMap = &_functions;
 }
@@ -87,43 +475,139 @@ void MessageLoop::setStopThread(bool st) {
     _task_exec_mtx.lock();
     _stop_thread = st;
     _task_exec_mtx.unlock();
-    _empty_mtx.unlock();
     if (st) {
         ChirpLogger::instance(_service_name) << "Main stopping thread." << std::endl;
+        // Force a wakeup regardless of whether the loop is currently waiting
+        signal();
     }
 }
 
 void MessageLoop::drainQueue() {
 
+    // Deferred messages belong to the schedule owner. A polled service shut
+    // down from inside poll() already owns it; otherwise nobody runs the loop
+    // any more and the destructor frees whatever is left.
+    if (_loop_thread == std::this_thread::get_id()) {
+        dropDeferredMessages();
+    } else if (_loop_mtx.try_lock()) {
+        dropDeferredMessages();
+        _loop_mtx.unlock();
+    }
+
     Message* m;
     _task_exec_mtx.lock();
-    while (!_message_queue.empty()) {
-        m = _message_queue.front();
-        delete m;
-        _message_queue.pop_front();
+    std::lock_guard<std::mutex> lock(_queue_mtx);
+    while ((m = popLocked()) != nullptr) {
+        Message::MessageType mt;
+        m->getMessageType(mt);
+        // Release a blocked sync caller, which then frees the message
+        if (mt == Message::MessageType::SYNC) {
+            m->sync_notify();
+        } else {
+            delete m;
+        }
     }
     _task_exec_mtx.unlock();
 }
 
 void MessageLoop::stop() {
-    
+
     setStopThread(true);
-    _empty_mtx.unlock();
+    if (_shared_timers.exchange(false)) {
+        SharedTimerThread::instance().detach(this);
+    }
+}
+
+void MessageLoop::requestStop() {
+
+    // setStopThread() waits on _task_exec_mtx for a running handler to return.
+    // The flag is atomic, so a plain store is enough to raise it meanwhile.
+    _stop_thread.store(true);
+    signal();
 }
 
-void MessageLoop::fireTimerHandlers(bool& st_thread) {
+size_t MessageLoop::fireTimerHandlers(bool& st_thread) {
+
+    size_t fired = 0;
 
-    // Timeout occurred, timers have elapsed
-    std::vector<ChirpTimer*> elapsedTimers;
+    // No timer handler is running here, so configurations retired while one
+    // was can go. Their names may be the one last published.
+    if (!_retired_timer_configs.empty()) {
+        _retired_timer_configs.clear();
+        _published_handler = nullptr;
+    }
+
+    // Timeout occurred, timers have elapsed. Both lists are members so
+    // their capacity is reused and firing does not allocate.
+    std::vector<ChirpTimer*>& elapsedTimers = _elapsed_timers;
     _timer_mgr.getElapsedTimers(elapsedTimers);
-    
+    if (elapsedTimers.empty()) {
+        st_thread = _stop_thread;
+        return fired;
+    }
+
+    // Timers still owned by the manager once their handlers have run
+    std::vector<ChirpTimer*>& rescheduled = _rescheduled_timers;
+    rescheduled.clear();
+
+    // Missed ticks are counted against the time the batch became due
+    auto batchTime = ChirpClock::now();
+
     // Process elapsed timers
     _task_exec_mtx.lock();
     for (ChirpTimer* timer : elapsedTimers) {
-        if (timer) {
-            std::string timerMsg = timer->getMessage();
-            
+        if (timer && timer->isRunning()) {
+            const ChirpTimer::FiringConfig* config = armedConfig(timer);
+            std::chrono::steady_clock::time_point due;
+            bool scheduled = _timer_mgr.getFiringTime(timer, due);
+
+            // Ticks after this one that are already due as well
+            uint64_t overdue = 0;
+            auto period = config->period;
+            if (scheduled && config->mode == IChirpTimer::TimerMode::PERIODIC &&
+                period.count() > 0 && batchTime - due >= period) {
+                overdue = static_cast<uint64_t>((batchTime - due) / period);
+            }
+
+            auto policy = timer->getMissedTickPolicy();
+            if (overdue > 0 && policy == IChirpTimer::MissedTickPolicy::SKIP) {
+                // Drop this tick too; rescheduleTimers moves on to the next aligned one
+                timer->recordMissedTicks(overdue + 1, false);
+                rescheduled.push_back(timer);
+                continue;
+            }
+            if (policy == IChirpTimer::MissedTickPolicy::COALESCE) {
+                timer->recordMissedTicks(overdue, true);
+            }
+
+            if (scheduled) {
+                timer->recordLateness(ChirpClock::now() - due);
+            }
+
+            // Release a one-shot timer before its handler runs, so the
+            // handler may delete or re-arm it. Its configuration stays
+            // with the loop until the batch is done.
+            if (config->mode == IChirpTimer::TimerMode::ONE_SHOT) {
+                _timer_mgr.removeTimer(timer);
+                _retired_timer_configs.push_back(timer->releaseFiringConfig());
+                timer->expire();
+            } else {
+                rescheduled.push_back(timer);
+            }
+
+            // Typed timers carry their handler and arguments, captured when
+            // the timer was armed
+            if (config->handler) {
+                auto started = ChirpClock::now();
+                beginHandler(config->message, true, started);
+                (*config->handler)();
+                endHandler(config->message, started);
+                fired++;
+                continue;
+            }
+
             // Call the handler for this timer
+            const std::string& timerMsg = config->message;
             auto it = _functions.find(timerMsg);
             if (it != _functions.end()) {
                 // Args vector must include the message name as first element,
@@ -131,65 +615,505 @@ void MessageLoop::fireTimerHandlers(bool& st_thread) {
                 std::vector<std::any> args;
                 args.push_back(timerMsg);  // Message name (required by handler framework)
                 args.push_back(timerMsg);  // Actual argument: the timer message
+                auto started = ChirpClock::now();
+                beginHandler(it->first, true, started);
                 it->second(args);
+                endHandler(it->first, started);
+                fired++;
             }
+        } else {
+            // Stopped timers are dropped from the schedule by rescheduleTimers
+            rescheduled.push_back(timer);
         }
     }
-    
+
     // Update st_thread before unlocking
     st_thread = _stop_thread;
     _task_exec_mtx.unlock();
 
     // Reschedule only the timers that just fired
-    _timer_mgr.rescheduleTimers(elapsedTimers);
-    
-    // Recompute which timer fires next, skipping the elapsed timers
-    _timer_mgr.computeNextTimerFirringTime();
+    _timer_mgr.rescheduleTimers(rescheduled, batchTime);
+
+    if (fired > 0) {
+        _timer_batches.fetch_add(1, std::memory_order_relaxed);
+        _timers_fired.fetch_add(fired, std::memory_order_relaxed);
+    }
+    return fired;
 }
 
-void MessageLoop::fireRegularHandlers(bool& st_thread) {
-    
+size_t MessageLoop::fireRegularHandlers(bool& st_thread) {
+
+    size_t fired = 0;
+
     _task_exec_mtx.lock();
-    if (!_message_queue.empty()) {
+    Message* m = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_queue_mtx);
+        m = popLocked();
+    }
+    // One clock read serves the sojourn, the expiry check and the handler start
+    auto now = m ? ChirpClock::now() : std::chrono::steady_clock::time_point{};
+    if (m) {
+        recordSojourn(m, now);
+    }
 
-        Message* m = _message_queue.front();
-        _message_queue.pop_front();
+    if (m && m->hasExpiry() && now >= m->getExpiry()) {
+        // Too late to matter: skip the argument copy, lookup and dispatch
+        expireMessage(m);
+        fired = 1;
+    } else if (m && isStale(m, now)) {
+        _messages_shed.fetch_add(1, std::memory_order_relaxed);
+        delete m;
+        fired = 1;
+    } else if (m) {
         std::string msg;
         std::vector<std::any> args;
         m->getMessage(msg);
         m->getArgs(args);
         auto it = _functions.find(msg);
         if (it != _functions.end()) {
+            beginHandler(it->first, true, now);
             it->second(args);
+            endHandler(it->first, now);
+        }
+        if (m->hasDeadline()) {
+            _deadline_messages.fetch_add(1, std::memory_order_relaxed);
+            if (ChirpClock::now() > m->getDeadline()) {
+                _deadline_misses.fetch_add(1, std::memory_order_relaxed);
+            }
         }
         Message::MessageType mt;
         m->getMessageType(mt);
+        // The sync caller frees its message after waking; deleting it here
+        // would race with the caller still re-acquiring the message's mutex
         if (mt == Message::MessageType::SYNC) {
             m->sync_notify();
+        } else {
+            delete m;
         }
-        delete m;
+        fired = 1;
     }
-    
+
     // Update st_thread before unlocking
     st_thread = _stop_thread;
     _task_exec_mtx.unlock();
+    return fired;
+}
+
+bool MessageLoop::isStale(Message* m, std::chrono::steady_clock::time_point now) const {
+
+    if (_shedding.load(std::memory_order_relaxed) != IChirp::SheddingPolicy::DROP_STALE) {
+        return false;
+    }
+    Message::MessageType mt;
+    m->getMessageType(mt);
+    // A sync caller is blocked waiting for its handler, never drop it
+    if (mt == Message::MessageType::SYNC) {
+        return false;
+    }
+    return now - m->getEnqueueTime() > std::chrono::nanoseconds(_shed_sojourn_ns.load(std::memory_order_relaxed));
+}
+
+void MessageLoop::recordSojourn(Message* m, std::chrono::steady_clock::time_point now) {
+
+    auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m->getEnqueueTime());
+    uint64_t ns = waited.count() > 0 ? static_cast<uint64_t>(waited.count()) : 0;
+    size_t bucket = std::min<size_t>(std::bit_width(ns), ChirpQueueStats::SojournBuckets - 1);
+    // Dispatch is serialized by _task_exec_mtx, so a relaxed load and store is enough
+    _sojourn[bucket].store(_sojourn[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void MessageLoop::beginHandler(const std::string& name, bool stableName, std::chrono::steady_clock::time_point started) {
+
+    const std::string* publish = (stableName && &name == _published_handler) ? nullptr : &name;
+    _published_handler = stableName ? &name : nullptr;
+    _heartbeat->enterHandler(std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch()).count(),
+                             publish);
+}
+
+void MessageLoop::endHandler(const std::string& name, std::chrono::steady_clock::time_point started) {
+
+    _heartbeat->exitHandler();
+
+    int64_t threshold = _slow_handler_ns.load(std::memory_order_relaxed);
+    if (threshold <= 0) {
+        return;
+    }
+    auto ran = std::chrono::duration_cast<std::chrono::nanoseconds>(ChirpClock::now() - started);
+    if (ran.count() <= threshold) {
+        return;
+    }
+
+    ChirpLogger::instance(_service_name) << "Slow handler " << name << " ran " << ran.count() << "ns" << std::endl;
+    std::lock_guard<std::mutex> lock(_slow_mtx);
+    if (_slow_handlers.size() == ChirpSlowHandler::LogCapacity) {
+        _slow_handlers.pop_front();
+    }
+    _slow_handlers.push_back(ChirpSlowHandler{name, started, ran});
+}
+
+void MessageLoop::expireMessage(Message* m) {
+
+    std::string msg;
+    m->getMessage(msg);
+    delete m;
+
+    _messages_expired.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(_expired_mtx);
+        _expired_counts[msg]++;
+    }
+    ChirpLogger::instance(_service_name) << "Message " << msg << " expired in the queue" << std::endl;
+
+    auto it = _functions.find(IChirp::ExpiredMessage);
+    if (it != _functions.end()) {
+        std::vector<std::any> args;
+        args.push_back(std::string(IChirp::ExpiredMessage));  // Message name (required by handler framework)
+        args.push_back(msg);                                  // Actual argument: the expired message's name
+        it->second(args);
+    }
+}
+
+size_t MessageLoop::fireFdHandlers(bool& st_thread) {
+
+    size_t fired = 0;
+    if (_ready_fds.empty()) {
+        return fired;
+    }
+
+    std::vector<std::pair<int, uint32_t>> ready;
+    ready.swap(_ready_fds);
+
+    _task_exec_mtx.lock();
+    for (const auto& [fd, events] : ready) {
+        std::shared_ptr<FdWatch> watch;
+        {
+            std::lock_guard<std::mutex> lock(_fd_mtx);
+            auto it = _fd_watches.find(fd);
+            if (it != _fd_watches.end()) {
+                watch = it->second;
+            }
+        }
+        // The watch may have been removed after the event was collected
+        if (watch) {
+            watch->callback(fd, events);
+            fired++;
+        }
+    }
+    st_thread = _stop_thread;
+    _task_exec_mtx.unlock();
+    return fired;
+}
+
+ChirpError::Error MessageLoop::addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback) {
+
+    if (fd < 0 || !callback || (events & (IChirp::FD_READABLE | IChirp::FD_WRITABLE)) == 0) {
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    std::lock_guard<std::mutex> lock(_fd_mtx);
+    if (_fd_watches.find(fd) != _fd_watches.end()) {
+        return ChirpError::HANDLER_ALREADY_EXISTS;
+    }
+
+    struct epoll_event ev {};
+    ev.events = ((events & IChirp::FD_READABLE) ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                ((events & IChirp::FD_WRITABLE) ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    ev.data.fd = fd;
+    if (epoll_ctl(_poll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        ChirpLogger::instance(_service_name) << "Cannot watch fd " << fd << ", errno " << errno << std::endl;
+        return ChirpError::INVALID_ARGUMENTS;
+    }
+
+    _fd_watches[fd] = std::make_shared<FdWatch>(FdWatch{events, std::move(callback)});
+    _fd_watch_count = _fd_watches.size();
+    return ChirpError::SUCCESS;
+}
+
+ChirpError::Error MessageLoop::removeFdWatch(int fd) {
+
+    std::lock_guard<std::mutex> lock(_fd_mtx);
+    auto it = _fd_watches.find(fd);
+    if (it == _fd_watches.end()) {
+        return ChirpError::HANDLER_NOT_FOUND;
+    }
+
+    // The descriptor may already be closed, in which case the kernel has
+    // dropped it from the epoll set on its own
+    epoll_ctl(_poll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    _fd_watches.erase(it);
+    _fd_watch_count = _fd_watches.size();
+    return ChirpError::SUCCESS;
 }
 
 void MessageLoop::addChirpTimer(ChirpTimer* timer) {
 
-    _timer_mgr.addTimer(timer);
-    // Always compute firing times and wake up the loop when a timer is added
-    // This ensures the timer schedule is updated immediately
-    _timer_mgr.computeNextTimerFirringTime();
-    // Wake up the message loop so it can recalculate the wait duration
-    _empty_mtx.unlock();
+    // Owned by the loop once queued; freed when applied
+    submitTimerCommand(new TimerCommand(TimerCommand::Op::ADD, timer));
 }
 
 void MessageLoop::removeChirpTimer(ChirpTimer* timer) {
 
-    _timer_mgr.removeTimer(timer);
-    // Recompute schedule after removing a timer
-    _timer_mgr.computeNextTimerFirringTime();
-    // Wake up the message loop so it can recalculate the wait duration
-    _empty_mtx.unlock();
-}
\ No newline at end of file
+    // Lives on this stack until the loop has applied it, after which the
+    // loop never touches the timer again and the caller may delete it
+    TimerCommand cmd(TimerCommand::Op::REMOVE, timer);
+    submitTimerCommand(&cmd);
+}
+
+void MessageLoop::submitTimerCommand(TimerCommand* cmd) {
+
+    bool wait = cmd->op == TimerCommand::Op::REMOVE;
+    _timer_cmds.push(cmd);
+    _pending_timer_cmds.fetch_add(1);
+
+    while (true) {
+        applyOrWakeLoop();
+
+        if (!wait) {
+            return;
+        }
+
+        // The loop may stop between our check and applying the command, so
+        // never wait unbounded; retry taking over instead
+        std::unique_lock<std::mutex> lock(_timer_cmd_mtx);
+        if (_timer_cmd_cv.wait_for(lock, std::chrono::milliseconds(1), [cmd] { return cmd->done; })) {
+            return;
+        }
+    }
+}
+
+void MessageLoop::applyOrWakeLoop() {
+
+    if (_loop_thread == std::this_thread::get_id()) {
+        // Called from a handler: the schedule is ours already
+        applyTimerCommands();
+    } else if (_loop_mtx.try_lock()) {
+        // Nobody is running the loop (not started, stopped, dormant, or a
+        // polled loop between polls), so apply the queue in its place
+        applyTimerCommands();
+        bool scheduled = _timer_mgr.getTimerCount() > 0 || _timer_mgr.getDeferredMessageCount() > 0;
+        _loop_mtx.unlock();
+        // A polled owner must poll again to re-arm the timerfd
+        notify();
+        // A dormant loop needs its thread back to wait for the schedule
+        if (scheduled) {
+            wakeIfDormant();
+        }
+    } else {
+        // Wake the loop so it applies the command before its next wait
+        notify();
+        wakeIfDormant();
+    }
+}
+
+void MessageLoop::applyTimerCommands() {
+
+    if (_pending_timer_cmds.load() == 0) {
+        return;
+    }
+
+    bool released = false;
+    while (MpscNode* node = _deferred_msgs.pop()) {
+        _pending_timer_cmds.fetch_sub(1);
+        _timer_mgr.addDeferredMessage(static_cast<Message*>(node));
+    }
+
+    while (MpscNode* node = _timer_cmds.pop()) {
+        _pending_timer_cmds.fetch_sub(1);
+
+        TimerCommand* cmd = static_cast<TimerCommand*>(node);
+        if (cmd->op == TimerCommand::Op::ADD) {
+            (void)armedConfig(cmd->timer);
+            _timer_mgr.addTimer(cmd->timer);
+            delete cmd;
+            continue;
+        }
+
+        _timer_mgr.removeTimer(cmd->timer);
+        // The caller may delete the timer once we are done, even from its own handler
+        _retired_timer_configs.push_back(cmd->timer->releaseFiringConfig());
+        // A handler may remove a timer that is still waiting in the current batch
+        std::replace(_elapsed_timers.begin(), _elapsed_timers.end(), cmd->timer, static_cast<ChirpTimer*>(nullptr));
+        std::replace(_rescheduled_timers.begin(), _rescheduled_timers.end(), cmd->timer, static_cast<ChirpTimer*>(nullptr));
+        {
+            std::lock_guard<std::mutex> lock(_timer_cmd_mtx);
+            cmd->done = true;
+        }
+        released = true;
+    }
+
+    if (released) {
+        _timer_cmd_cv.notify_all();
+    }
+}
+
+const ChirpTimer::FiringConfig* MessageLoop::armedConfig(ChirpTimer* timer) {
+
+    if (timer->firingConfigStale()) {
+        _retired_timer_configs.push_back(timer->captureFiringConfig());
+    }
+    return timer->firingConfig();
+}
+
+void MessageLoop::releaseDeferredMessages() {
+
+    if (_timer_mgr.getDeferredMessageCount() == 0) {
+        return;
+    }
+
+    std::vector<Message*>& due = _due_msgs;
+    _timer_mgr.getDueMessages(due);
+    if (due.empty()) {
+        return;
+    }
+
+    // Due messages join the back of the queue, behind anything posted
+    // before they became due
+    {
+        std::lock_guard<std::mutex> lock(_queue_mtx);
+        for (Message* m : due) {
+            pushLocked(m, EnqueuePosition::ENQUEUE_BACK);
+        }
+    }
+    due.clear();
+}
+
+void MessageLoop::dropDeferredMessages() {
+
+    while (MpscNode* node = _deferred_msgs.pop()) {
+        _pending_timer_cmds.fetch_sub(1);
+        delete static_cast<Message*>(node);
+    }
+
+    std::vector<Message*> pending;
+    _timer_mgr.takeDeferredMessages(pending);
+    for (Message* m : pending) {
+        delete m;
+    }
+}
+
+void MessageLoop::openWakeupFds() {
+
+    _wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    _poll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_wake_fd < 0 || _timer_fd < 0 || _poll_fd < 0) {
+        ChirpLogger::instance(_service_name) << "Failed to create wakeup descriptors, errno " << errno << std::endl;
+        return;
+    }
+
+    struct epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.fd = _wake_fd;
+    epoll_ctl(_poll_fd, EPOLL_CTL_ADD, _wake_fd, &ev);
+    ev.data.fd = _timer_fd;
+    epoll_ctl(_poll_fd, EPOLL_CTL_ADD, _timer_fd, &ev);
+}
+
+void MessageLoop::closeWakeupFds() {
+
+    for (int* fd : {&_poll_fd, &_wake_fd, &_timer_fd}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void MessageLoop::notify() {
+
+    // Only pay for the eventfd write when the loop (or the poll fd owner)
+    // is actually waiting for a wakeup
+    if (_wake_armed.exchange(false)) {
+        signal();
+    }
+}
+
+void MessageLoop::signal() {
+
+    uint64_t one = 1;
+    ssize_t rc = write(_wake_fd, &one, sizeof(one));
+    (void)rc;
+}
+
+void MessageLoop::armWakeup() {
+
+    _wake_armed = true;
+    if (hasPendingMessages() || _pending_timer_cmds.load() > 0 || _stop_thread) {
+        _wake_armed = false;
+    }
+}
+
+void MessageLoop::armTimerFd() {
+
+    // A default constructed _armed_deadline means the timerfd is disarmed
+    // Under virtual time deadlines are not wall-clock instants; whoever
+    // advances the clock is responsible for polling the loop
+    std::chrono::steady_clock::time_point deadline{};
+    if (ChirpClock::isVirtual() || !_timer_mgr.getNextTimerFiringTime(deadline)) {
+        deadline = std::chrono::steady_clock::time_point{};
+    }
+    if (deadline == _armed_deadline) {
+        return;
+    }
+    if (_shared_timers) {
+        SharedTimerThread::instance().schedule(this, deadline);
+        _armed_deadline = deadline;
+        return;
+    }
+    bool hasTimer = deadline != std::chrono::steady_clock::time_point{};
+
+    // steady_clock is CLOCK_MONOTONIC, so the deadline can be armed as an
+    // absolute expiry. A zero it_value disarms the timer.
+    struct itimerspec spec {};
+    if (hasTimer) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+        if (ns <= 0) {
+            ns = 1;
+        }
+        spec.it_value.tv_sec = ns / 1000000000;
+        spec.it_value.tv_nsec = ns % 1000000000;
+    }
+    timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    _armed_deadline = deadline;
+}
+
+void MessageLoop::waitForEvents(int timeoutMs) {
+
+    struct epoll_event events[64];
+    int rc = epoll_wait(_poll_fd, events, 64, timeoutMs);
+    if (rc < 0 && errno != EINTR) {
+        ChirpLogger::instance(_service_name) << "epoll_wait failed, errno " << errno << std::endl;
+    }
+    for (int i = 0; i < rc; ++i) {
+        int fd = events[i].data.fd;
+        if (fd == _wake_fd || fd == _timer_fd) {
+            continue;
+        }
+        uint32_t ready = 0;
+        ready |= (events[i].events & EPOLLIN)  ? static_cast<uint32_t>(IChirp::FD_READABLE) : 0u;
+        ready |= (events[i].events & EPOLLOUT) ? static_cast<uint32_t>(IChirp::FD_WRITABLE) : 0u;
+        ready |= (events[i].events & EPOLLERR) ? static_cast<uint32_t>(IChirp::FD_ERROR) : 0u;
+        ready |= (events[i].events & (EPOLLHUP | EPOLLRDHUP)) ? static_cast<uint32_t>(IChirp::FD_HANGUP) : 0u;
+        _ready_fds.emplace_back(fd, ready);
+    }
+}
+
+void MessageLoop::harvestFdEvents() {
+
+    // Descriptors are level triggered, so anything still unread from the
+    // previous round is simply reported again
+    _ready_fds.clear();
+    waitForEvents(0);
+}
+
+void MessageLoop::clearEvents() {
+
+    uint64_t value = 0;
+    ssize_t rc = read(_wake_fd, &value, sizeof(value));
+    rc = read(_timer_fd, &value, sizeof(value));
+    if (rc > 0 || _shared_timer_fired.exchange(false)) {
+        // The armed deadline has expired; force a re-arm for the next one
+        _armed_deadline = std::chrono::steady_clock::time_point{};
+    }
+}
@@ -8,11 +8,22 @@
 #include <any>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <array>
+
+#include <condition_variable>
+#include <thread>
 
 #include "message.h"
+#include "mpsc_queue.h"
+#include "chirp_heartbeat.h"
 #include "chirp_error.h"
 #include "timer_mgr.h"
 #include "chirp_timer.h"
+#include "ichirp.h"
 
 class MessageLoop {
 
@@ -25,33 +36,207 @@ public:
         ENQUEUE_BACK    /**< Add message to the back of the queue */
     };
 
-    MessageLoop() = default;
-    ~MessageLoop() = default;
+    MessageLoop();
+    ~MessageLoop();
 
     void spin();
     void enqueue(Message* m);
     void enqueueSync(Message* m);
+    // Safe from any thread. The loop holds the message in its timer
+    // schedule and moves it to the back of the queue once due is reached.
+    void enqueueDeferred(Message* m, std::chrono::steady_clock::time_point due);
     void setServiceName(const std::string& service_name);
-    void getCbMap(std::map<std::string, 
+    void getCbMap(std::map<std::string,
                   std::function<ChirpError::Error(std::vector<std::any>)>>*& funcMap);
 
     void stop();
+    // Ask the loop to exit after the handler it is running, without waiting for that handler
+    void requestStop();
     void drainQueue();
+
+    // Safe from any thread. Both are applied by the thread that runs the
+    // loop; removeChirpTimer() returns once the loop has let go of the timer.
     void addChirpTimer(ChirpTimer* timer);
     void removeChirpTimer(ChirpTimer* timer);
 
+    // File descriptor watchers dispatched on the loop thread
+    ChirpError::Error addFdWatch(int fd, uint32_t events, std::function<void(int, uint32_t)> callback);
+    ChirpError::Error removeFdWatch(int fd);
+
+    // Poll mode: the loop is driven by a caller-owned thread instead of spin()
+    void prepare();
+    size_t poll(size_t budget);
+    size_t runFor(const std::chrono::milliseconds& duration);
+    int getPollFd() const;
+    bool getNextTimerDeadline(std::chrono::steady_clock::time_point& deadline) const;
+    void getServiceStats(ChirpServiceStats& stats) const;
+    void getQueueStats(ChirpQueueStats& stats) const;
+
+    // Shared so a watchdog may keep reading it after the service is destroyed
+    std::shared_ptr<const ChirpHeartbeat> getHeartbeat() const;
+    void setWatchDogMonitoring(bool enabled);
+
+    // Called by SharedTimerThread when the deadline this loop handed it has passed
+    void sharedTimerDue();
+    void getExpiredMsgCounts(std::map<std::string, uint64_t>& counts) const;
+    void setSlowHandlerThreshold(const std::chrono::nanoseconds& threshold);
+    void getSlowHandlers(std::vector<ChirpSlowHandler>& log) const;
+    void setSchedulingPolicy(IChirp::SchedulingPolicy policy);
+    IChirp::SchedulingPolicy getSchedulingPolicy() const;
+    void setLoadShedding(IChirp::SheddingPolicy policy, const std::chrono::nanoseconds& maxSojourn);
+    IChirp::SheddingPolicy getLoadShedding() const;
+    bool admitPost();
+
+    // Lazy activation. activate() must give a dormant loop a thread running
+    // spin(); release() is called by an idle spin() and returns true if the
+    // loop went dormant, in which case spin() returns.
+    void setActivation(std::function<void()> activate, std::function<bool()> release);
+    void setIdleTimeout(const std::chrono::milliseconds& timeout);
+    void setDormant(bool dormant);
+    bool isDormant() const;
+    void countActivation();
+    // Loop owner only: anything queued, scheduled or watched
+    bool hasWork();
+
 private:
 
     void setStopThread(bool st);
     void enqueueInternal(Message* m, Message::MessageType type, EnqueuePosition position = EnqueuePosition::ENQUEUE_BACK);
-    void fireTimerHandlers(bool& st_thread);
-    void fireRegularHandlers(bool& st_thread);
-    
+    size_t fireTimerHandlers(bool& st_thread);
+    size_t fireRegularHandlers(bool& st_thread);
+    bool hasPendingMessages();
+    size_t fireFdHandlers(bool& st_thread);
+    void expireMessage(Message* m);
+    bool isStale(Message* m, std::chrono::steady_clock::time_point now) const;
+    void recordSojourn(Message* m, std::chrono::steady_clock::time_point now);
+
+    // Bracket every handler call. name must outlive the loop when stableName is
+    // set, so the heartbeat can skip re-copying it for back-to-back repeats.
+    void beginHandler(const std::string& name, bool stableName, std::chrono::steady_clock::time_point started);
+    void endHandler(const std::string& name, std::chrono::steady_clock::time_point started);
+
+    // Run queue access, all called with _queue_mtx held. Under FIFO the
+    // queue is _message_queue; under EDF it is _deadline_queue.
+    void pushLocked(Message* m, EnqueuePosition position);
+    Message* popLocked();
+    bool queueEmptyLocked() const;
+
+    struct DeadlineEntry {
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence;  // Posting order, breaks ties
+        Message* message;
+    };
+    static bool dispatchedAfter(const DeadlineEntry& a, const DeadlineEntry& b);
+
+    // Wakeup plumbing. The loop waits on _poll_fd (an epoll set holding an
+    // eventfd for queue activity and a timerfd armed at the next timer
+    // deadline), so the same descriptor serves spin() and external reactors.
+    void openWakeupFds();
+    void closeWakeupFds();
+    void notify();
+    void signal();
+    void armWakeup();
+    void armTimerFd();
+    void waitForEvents(int timeoutMs);
+    void harvestFdEvents();
+    void clearEvents();
+
+    // Timer add/remove requests, queued by any thread for the loop to apply
+    struct TimerCommand : MpscNode {
+        enum class Op { ADD, REMOVE };
+        TimerCommand(Op o, ChirpTimer* t) : op(o), timer(t) {}
+        Op op;
+        ChirpTimer* timer;
+        bool done = false;  // REMOVE only, guarded by _timer_cmd_mtx
+    };
+    void submitTimerCommand(TimerCommand* cmd);
+    void applyTimerCommands();
+    // Captures the timer's configuration again if it changed since it was armed
+    const ChirpTimer::FiringConfig* armedConfig(ChirpTimer* timer);
+    void applyOrWakeLoop();
+    void releaseDeferredMessages();
+    void dropDeferredMessages();
+    void wakeIfDormant();
+    int idleWaitMs();
+
     std::deque<Message*> _message_queue;
+    std::vector<DeadlineEntry> _deadline_queue;  // Min-heap on (deadline, sequence)
+    uint64_t _queue_sequence = 0;
+    IChirp::SchedulingPolicy _policy = IChirp::SchedulingPolicy::FIFO;
+    mutable std::mutex _queue_mtx;
     std::string _service_name;
     std::map<std::string, std::function<ChirpError::Error(std::vector<std::any>)>> _functions;
-    std::timed_mutex _empty_mtx;
     std::mutex _task_exec_mtx;
-    volatile bool _stop_thread;
+    std::atomic<bool> _stop_thread{false};
+    std::atomic<bool> _wake_armed{false};
     TimerManager _timer_mgr;
+    std::vector<ChirpTimer*> _elapsed_timers;      // Scratch lists reused by fireTimerHandlers()
+    std::vector<ChirpTimer*> _rescheduled_timers;
+    // Timer configurations a running handler may still use, freed at the next batch
+    std::vector<std::shared_ptr<const ChirpTimer::FiringConfig>> _retired_timer_configs;
+
+    // The timer schedule belongs to whoever holds _loop_mtx: the spinning
+    // thread, a thread inside poll(), or a caller applying commands while
+    // no one runs the loop
+    MpscQueue _timer_cmds;
+    MpscQueue _deferred_msgs;                      // Posted with a delay, not yet in the schedule
+    std::atomic<size_t> _pending_timer_cmds{0};    // Counts both queues above
+    std::vector<Message*> _due_msgs;               // Scratch list reused by releaseDeferredMessages()
+    mutable std::mutex _loop_mtx;
+    std::atomic<std::thread::id> _loop_thread{};
+    std::mutex _timer_cmd_mtx;
+    std::condition_variable _timer_cmd_cv;
+
+    struct FdWatch {
+        uint32_t events;
+        std::function<void(int, uint32_t)> callback;
+    };
+    std::map<int, std::shared_ptr<FdWatch>> _fd_watches;
+    std::mutex _fd_mtx;
+    std::atomic<size_t> _fd_watch_count{0};
+    std::vector<std::pair<int, uint32_t>> _ready_fds;
+
+    int _poll_fd = -1;
+    int _wake_fd = -1;
+    int _timer_fd = -1;
+    std::chrono::steady_clock::time_point _armed_deadline{};
+
+    // Set while the loop hands its deadlines to SharedTimerThread instead of _timer_fd
+    std::atomic<bool> _shared_timers{false};
+    std::atomic<bool> _shared_timer_fired{false};
+
+    std::shared_ptr<ChirpHeartbeat> _heartbeat = std::make_shared<ChirpHeartbeat>();
+    const std::string* _published_handler = nullptr;   // Name last copied into _heartbeat
+
+    // Handlers that ran longer than _slow_handler_ns, newest at the back
+    std::atomic<int64_t> _slow_handler_ns{0};
+    std::deque<ChirpSlowHandler> _slow_handlers;
+    mutable std::mutex _slow_mtx;
+
+    // Loop counters, written by the loop thread only
+    std::atomic<uint64_t> _wakeups{0};
+    std::atomic<uint64_t> _timer_batches{0};
+    std::atomic<uint64_t> _timers_fired{0};
+    std::atomic<uint64_t> _messages_expired{0};
+    std::atomic<uint64_t> _deadline_messages{0};
+    std::atomic<uint64_t> _deadline_misses{0};
+    std::atomic<uint64_t> _messages_shed{0};       // Also counted by posting threads
+
+    // Load shedding, read on every post and dequeue
+    std::atomic<IChirp::SheddingPolicy> _shedding{IChirp::SheddingPolicy::NONE};
+    std::atomic<int64_t> _shed_sojourn_ns{0};
+
+    // Lazy activation, see setActivation()
+    std::function<void()> _activate;
+    std::function<bool()> _release;
+    std::atomic<bool> _dormant{false};
+    std::atomic<int64_t> _idle_timeout_ns{0};
+    std::atomic<uint64_t> _activations{0};
+
+    // Sojourn histogram, see ChirpQueueStats for the bucket layout
+    std::array<std::atomic<uint64_t>, ChirpQueueStats::SojournBuckets> _sojourn{};
+
+    // Messages discarded at dequeue because their expiry had passed
+    std::map<std::string, uint64_t> _expired_counts;
+    mutable std::mutex _expired_mtx;
 };
@@ -0,0 +1,85 @@
+/**
+ * @file mpsc_queue.h
+ * @brief Intrusive unbounded multi-producer/single-consumer queue
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * Any number of threads may push; one thread at a time may pop. A push is a
+ * single atomic exchange and never blocks or allocates, since the caller
+ * supplies the node. Nodes are handed back in push order, and the queue
+ * never touches a node again once pop() has returned it.
+ */
+
+#pragma once
+#include <atomic>
+
+/**
+ * @brief Link embedded in every queued object
+ */
+struct MpscNode {
+    std::atomic<MpscNode*> next{nullptr};
+};
+
+class MpscQueue {
+public:
+    MpscQueue()
+        : _head(&_stub), _tail(&_stub) {
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Producer side, safe from any thread
+    void push(MpscNode* node) {
+
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer side. Returns nullptr when the queue is empty, or when the
+    // next node's producer is between its exchange and its link; that
+    // producer finishes within a few instructions, so retry later.
+    MpscNode* pop() {
+
+        MpscNode* tail = _tail;
+        MpscNode* next = tail->next.load(std::memory_order_acquire);
+
+        // Step over the stub, it is not a real node
+        if (tail == &_stub) {
+            if (!next) {
+                return nullptr;
+            }
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            _tail = next;
+            return tail;
+        }
+
+        if (tail != _head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        // tail is the last node: queue the stub behind it so it can be detached
+        push(&_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            _tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    // Producer-shared line
+    alignas(64) std::atomic<MpscNode*> _head;
+
+    // Consumer-owned line
+    alignas(64) MpscNode* _tail;
+    MpscNode _stub;
+};
@@ -0,0 +1,192 @@
+/**
+ * @file shared_timer_thread.cpp
+ * @brief Implementation of the process-wide shared timer thread
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ */
+
+#include <cstdint>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+
+#include "shared_timer_thread.h"
+#include "message_loop.h"
+
+SharedTimerThread& SharedTimerThread::instance() {
+
+    static SharedTimerThread sharedTimers;
+    return sharedTimers;
+}
+
+SharedTimerThread::~SharedTimerThread() {
+
+    // Loops still attached at exit are not woken any more
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _loops.clear();
+        _deadlines.clear();
+    }
+    if (_thread.joinable()) {
+        uint64_t one = 1;
+        ssize_t rc = write(_stop_fd, &one, sizeof(one));
+        (void)rc;
+        _thread.join();
+    }
+}
+
+bool SharedTimerThread::setEnabled(bool enable) {
+
+    std::unique_lock<std::mutex> lock(_mtx);
+    if (enable == _enabled) {
+        return true;
+    }
+
+    if (enable) {
+        _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        _stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_timer_fd < 0 || _stop_fd < 0) {
+            for (int* fd : {&_timer_fd, &_stop_fd}) {
+                if (*fd >= 0) {
+                    close(*fd);
+                    *fd = -1;
+                }
+            }
+            return false;
+        }
+        _armed = std::chrono::steady_clock::time_point{};
+        _enabled = true;
+        _thread = std::thread(&SharedTimerThread::run, this);
+        return true;
+    }
+
+    // Attached loops rely on this thread to wake them
+    if (!_loops.empty()) {
+        return false;
+    }
+    _enabled = false;
+    uint64_t one = 1;
+    ssize_t rc = write(_stop_fd, &one, sizeof(one));
+    (void)rc;
+    lock.unlock();
+
+    _thread.join();
+    close(_timer_fd);
+    close(_stop_fd);
+    _timer_fd = -1;
+    _stop_fd = -1;
+    return true;
+}
+
+bool SharedTimerThread::isEnabled() {
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _enabled;
+}
+
+bool SharedTimerThread::attach(MessageLoop* loop) {
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (!_enabled) {
+        return false;
+    }
+    _loops.emplace(loop, std::chrono::steady_clock::time_point{});
+    return true;
+}
+
+void SharedTimerThread::detach(MessageLoop* loop) {
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _loops.find(loop);
+    if (it == _loops.end()) {
+        return;
+    }
+    _deadlines.erase({it->second, loop});
+    _loops.erase(it);
+}
+
+void SharedTimerThread::schedule(MessageLoop* loop, std::chrono::steady_clock::time_point deadline) {
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _loops.find(loop);
+    if (it == _loops.end()) {
+        return;
+    }
+
+    _deadlines.erase({it->second, loop});
+    it->second = deadline;
+    if (deadline != std::chrono::steady_clock::time_point{}) {
+        _deadlines.emplace(deadline, loop);
+    }
+    armLocked();
+}
+
+void SharedTimerThread::run() {
+
+    // Same reasoning as MessageLoop::spin(): keep kernel timer slack minimal
+    prctl(PR_SET_TIMERSLACK, 1UL, 0, 0, 0);
+
+    struct pollfd fds[2];
+    fds[0].fd = _timer_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = _stop_fd;
+    fds[1].events = POLLIN;
+
+    while (true) {
+        int rc = ::poll(fds, 2, -1);
+        if (rc < 0) {
+            continue;
+        }
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+
+        uint64_t expirations = 0;
+        ssize_t n = read(_timer_fd, &expirations, sizeof(expirations));
+        (void)n;
+
+        std::lock_guard<std::mutex> lock(_mtx);
+        _armed = std::chrono::steady_clock::time_point{};
+        fireDue();
+        armLocked();
+    }
+}
+
+void SharedTimerThread::fireDue() {
+
+    auto now = std::chrono::steady_clock::now();
+    while (!_deadlines.empty() && _deadlines.begin()->first <= now) {
+        MessageLoop* loop = _deadlines.begin()->second;
+        _deadlines.erase(_deadlines.begin());
+        _loops[loop] = std::chrono::steady_clock::time_point{};
+        // The loop re-registers its next deadline once it has fired its timers
+        loop->sharedTimerDue();
+    }
+}
+
+void SharedTimerThread::armLocked() {
+
+    std::chrono::steady_clock::time_point earliest{};
+    if (!_deadlines.empty()) {
+        earliest = _deadlines.begin()->first;
+    }
+    if (earliest == _armed) {
+        return;
+    }
+
+    // An absolute CLOCK_MONOTONIC expiry; a zero it_value disarms the timer
+    struct itimerspec spec {};
+    if (earliest != std::chrono::steady_clock::time_point{}) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(earliest.time_since_epoch()).count();
+        if (ns <= 0) {
+            ns = 1;
+        }
+        spec.it_value.tv_sec = ns / 1000000000;
+        spec.it_value.tv_nsec = ns % 1000000000;
+    }
+    timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    _armed = earliest;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file shared_timer_thread.h
+ * @brief Process-wide thread that waits on timer deadlines for many services
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * Without it every service arms a timerfd of its own at its next timer
+ * deadline. With it, attached services hand that deadline to one thread
+ * instead. The thread keeps every service's next deadline in one ordered set,
+ * waits on a single timerfd armed at the earliest of them, and wakes only the
+ * service whose deadline has passed. A service without due work is never woken.
+ */
+
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+class MessageLoop;
+
+class SharedTimerThread {
+public:
+    /**
+     * @brief The process-wide instance
+     */
+    static SharedTimerThread& instance();
+
+    SharedTimerThread(const SharedTimerThread&) = delete;
+    SharedTimerThread& operator=(const SharedTimerThread&) = delete;
+
+    /**
+     * @brief Start or stop the thread
+     * @param enable true to start it, false to stop it
+     * @return false if stopping was refused because services are still attached
+     */
+    bool setEnabled(bool enable);
+
+    bool isEnabled();
+
+    /**
+     * @brief Let a loop hand its timer deadlines to the shared thread
+     * @return false if the shared thread is not enabled; the loop then keeps its own timerfd
+     */
+    bool attach(MessageLoop* loop);
+
+    /**
+     * @brief Forget a loop and its deadline
+     *
+     * Once this returns the shared thread never calls into the loop again.
+     */
+    void detach(MessageLoop* loop);
+
+    /**
+     * @brief Set or clear a loop's next timer deadline
+     * @param deadline Absolute deadline; default constructed to clear it
+     *
+     * Ignored for loops that are not attached. When the deadline passes the
+     * entry is dropped and the loop is woken through MessageLoop::sharedTimerDue().
+     */
+    void schedule(MessageLoop* loop, std::chrono::steady_clock::time_point deadline);
+
+private:
+    SharedTimerThread() = default;
+    ~SharedTimerThread();
+
+    void run();
+    void fireDue();   // Called with _mtx held
+    void armLocked();
+
+    std::mutex _mtx;
+    std::thread _thread;
+    bool _enabled = false;
+    int _timer_fd = -1;
+    int _stop_fd = -1;
+    std::chrono::steady_clock::time_point _armed{};
+
+    // Next deadline of every attached loop that has one, earliest first
+    std::set<std::pair<std::chrono::steady_clock::time_point, MessageLoop*>> _deadlines;
+    // Every attached loop, with its entry in _deadlines (default time point if none)
+    std::unordered_map<MessageLoop*, std::chrono::steady_clock::time_point> _loops;
+};
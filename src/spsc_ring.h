@@ -0,0 +1,84 @@
+/**
+ * @file spsc_ring.h
+ * @brief Bounded single-producer/single-consumer ring buffer
+ * @author Chirp Team
+ * @date 2025
+ * @version 2.0
+ *
+ * Exactly one thread may push and exactly one thread may pop. Neither side
+ * takes a lock; each only publishes its own index and caches the other one
+ * so the shared cache line is touched only when the cached view runs out.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : _slots(capacity), _capacity(capacity) {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side. Returns false, leaving item untouched, when the ring is full
+    bool tryPush(T& item) {
+
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead == _capacity) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead == _capacity) {
+                return false;
+            }
+        }
+        _slots[tail % _capacity] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the ring is empty
+    bool tryPop(T& item) {
+
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) {
+                return false;
+            }
+        }
+        item = std::move(_slots[head % _capacity]);
+        _slots[head % _capacity] = T();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while either side is active
+    size_t size() const {
+
+        size_t tail = _tail.load(std::memory_order_acquire);
+        size_t head = _head.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    size_t capacity() const {
+
+        return _capacity;
+    }
+
+private:
+    std::vector<T> _slots;
+    const size_t _capacity;
+
+    // Consumer-owned line
+    alignas(64) std::atomic<size_t> _head{0};
+    size_t _cachedTail = 0;
+
+    // Producer-owned line
+    alignas(64) std::atomic<size_t> _tail{0};
+    size_t _cachedHead = 0;
+};
@@ -7,6 +7,8 @@
  */
 
 #include "timer_mgr.h"
+#include "chirp_clock.h"
+#include "message.h"
 #include <algorithm>
 #include <iostream>
 
@@ -19,65 +21,71 @@ TimerManager::~TimerManager() {
 void TimerManager::addTimer(ChirpTimer* chirpTimer) {
     
     if (chirpTimer) {
-        _timers.push_back(chirpTimer);
-        auto currentTime = std::chrono::steady_clock::now();
-        std::chrono::milliseconds duration = chirpTimer->getDuration();
-        auto nextFiringTime = currentTime + duration;
-                    
-        // Add the new timer to the vector
-        _timerFiringTimes.push_back(std::make_pair(chirpTimer, nextFiringTime));
+        std::chrono::steady_clock::time_point nextFiringTime;
+        if (!chirpTimer->getDeadline(nextFiringTime)) {
+            nextFiringTime = ChirpClock::now() + chirpTimer->getDurationNs();
+        }
+
+        size_t index = slotOf(chirpTimer);
+        if (index != ChirpTimer::NotScheduled) {
+            // Already scheduled: restart its period instead of adding a duplicate
+            _heap[index].firingTime = nextFiringTime;
+            _heap[index].slack = chirpTimer->getSlack();
+            _heap[index].sequence = _nextSequence++;
+            restore(index);
+            return;
+        }
+
+        _heap.push_back(HeapEntry{chirpTimer, nextFiringTime, chirpTimer->getSlack(), _nextSequence++});
+        siftUp(_heap.size() - 1);
     }
 }
 
 void TimerManager::removeTimer(ChirpTimer* chirpTimer) {
 
-    // Remove from main timers list
-    auto it = std::find(_timers.begin(), _timers.end(), chirpTimer);
-    if (it != _timers.end()) {
-        _timers.erase(it);
-    }
-    
-    // Remove from firing times list
-    auto firingIt = std::find_if(_timerFiringTimes.begin(), _timerFiringTimes.end(),
-        [chirpTimer](const std::pair<ChirpTimer*, std::chrono::steady_clock::time_point>& pair) {
-            return pair.first == chirpTimer;
-        });
-    
-    if (firingIt != _timerFiringTimes.end()) {
-        _timerFiringTimes.erase(firingIt);
+    size_t index = slotOf(chirpTimer);
+    if (index != ChirpTimer::NotScheduled) {
+        eraseAt(index);
     }
 }
 
-void TimerManager::computeNextTimerFirringTime() {
+bool TimerManager::getNextTimerFiringTime(std::chrono::steady_clock::time_point& firingTime) const {
 
-    // Find the index of the timer with the lowest firing time
-    if (!_timerFiringTimes.empty()) {
-        _nextFirringTimerIndex = 0;
-        _nextFiringTime = _timerFiringTimes[0].second;
-        
-        for (size_t i = 1; i < _timerFiringTimes.size(); ++i) {
-            if (_timerFiringTimes[i].second < _nextFiringTime) {
-                _nextFirringTimerIndex = i;
-                _nextFiringTime = _timerFiringTimes[i].second;
-            }
+    if (_heap.empty()) {
+        if (_deferred.empty()) {
+            return false;
         }
+        firingTime = _deferred.front().due;
+        return true;
     }
-}
 
-std::chrono::milliseconds TimerManager::getDurationToNextTimerEvent() const {
-
-    std::chrono::milliseconds result = std::chrono::milliseconds(0);
-    
-    if (!_timerFiringTimes.empty()) {
-        auto currentTime = std::chrono::steady_clock::now();
-        
-        if (_nextFiringTime > currentTime) {
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(_nextFiringTime - currentTime);
-            result = duration;
+    // The wakeup is the end of the earliest slack window. Only timers that
+    // become due before the best window end found so far can end theirs
+    // sooner, so the walk stays within the batch that wakeup will fire.
+    auto wakeup = _heap.front().firingTime + _heap.front().slack;
+    std::vector<size_t>& pending = _walk;
+    pending.assign(1, 0);
+    while (!pending.empty()) {
+        size_t index = pending.back();
+        pending.pop_back();
+        const HeapEntry& entry = _heap[index];
+        if (entry.firingTime >= wakeup) {
+            continue;
+        }
+        wakeup = std::min(wakeup, entry.firingTime + entry.slack);
+        size_t left = 2 * index + 1;
+        if (left < _heap.size()) {
+            pending.push_back(left);
+        }
+        if (left + 1 < _heap.size()) {
+            pending.push_back(left + 1);
         }
     }
-    
-    return result;
+    if (!_deferred.empty()) {
+        wakeup = std::min(wakeup, _deferred.front().due);
+    }
+    firingTime = wakeup;
+    return true;
 }
 
 void TimerManager::getElapsedTimers(std::vector<ChirpTimer*>& elapsedTimers) const {
@@ -85,42 +93,222 @@ void TimerManager::getElapsedTimers(std::vector<ChirpTimer*>& elapsedTimers) con
     // Clear the output vector first
     elapsedTimers.clear();
     
-    // Get current time
-    auto currentTime = std::chrono::steady_clock::now();
-    
-    // Iterate through all timer firing times to find elapsed timers
-    // We add a small tolerance (10ms) to account for scheduling delays and timing precision
-    for (const auto& timerPair : _timerFiringTimes) {
-        if (timerPair.second <= currentTime + std::chrono::milliseconds(2)) {
-            // Timer has elapsed or is about to, add it to the result list
-            elapsedTimers.push_back(timerPair.first);
+    // No early-fire tolerance: the loop wakes on an absolute nanosecond
+    // deadline, so a timer is due exactly when its firing time has passed
+    auto limit = ChirpClock::now();
+
+    // Only descend into subtrees whose root is due; a heap parent is never
+    // later than its children, so everything below a pending node is pending too
+    if (_heap.empty() || _heap.front().firingTime > limit) {
+        return;
+    }
+    std::vector<const HeapEntry*>& due = _due;
+    std::vector<size_t>& pending = _walk;
+    due.clear();
+    pending.assign(1, 0);
+    while (!pending.empty()) {
+        size_t index = pending.back();
+        pending.pop_back();
+        if (_heap[index].firingTime > limit) {
+            continue;
+        }
+        due.push_back(&_heap[index]);
+        size_t left = 2 * index + 1;
+        if (left < _heap.size()) {
+            pending.push_back(left);
+        }
+        if (left + 1 < _heap.size()) {
+            pending.push_back(left + 1);
         }
     }
+
+    std::sort(due.begin(), due.end(), [this](const HeapEntry* a, const HeapEntry* b) {
+        return earlier(*a, *b);
+    });
+    elapsedTimers.reserve(due.size());
+    for (const HeapEntry* entry : due) {
+        elapsedTimers.push_back(entry->timer);
+    }
 }
 
 void TimerManager::rescheduleTimers(const std::vector<ChirpTimer*>& firedTimers) {
+
+    rescheduleTimers(firedTimers, ChirpClock::now());
+}
+
+void TimerManager::rescheduleTimers(const std::vector<ChirpTimer*>& firedTimers,
+                                    std::chrono::steady_clock::time_point now) {
     
     // Reschedule only the timers that have fired
     for (ChirpTimer* timer : firedTimers) {
-        if (timer && timer->isRunning()) {
-            // Find the timer in the firing times vector
-            auto it = std::find_if(_timerFiringTimes.begin(), _timerFiringTimes.end(),
-                [timer](const std::pair<ChirpTimer*, std::chrono::steady_clock::time_point>& pair) {
-                    return pair.first == timer;
-                });
-            
-            if (it != _timerFiringTimes.end()) {
-                // Timer exists, use its current firing time as the base for the next one
-                auto startTime = it->second;
-                std::chrono::milliseconds duration = timer->getDuration();
-                auto nextFiringTime = startTime + duration;
-                
-                _timerFiringTimes.erase(it);
-                
-                // Add the updated timer with new firing time
-                _timerFiringTimes.push_back(std::make_pair(timer, nextFiringTime));
+        size_t index = slotOf(timer);
+        if (index == ChirpTimer::NotScheduled) {
+            // Removed by a handler while the batch was being dispatched
+            continue;
+        }
+
+        // A loop captures the configuration when it arms the timer; without
+        // a loop there is none, so ask the timer itself
+        const ChirpTimer::FiringConfig* config = timer->firingConfig();
+        auto mode = config ? config->mode : timer->getMode();
+        if (!timer->isRunning()) {
+            // A stopped timer must not keep an elapsed firing time around,
+            // otherwise it would be reported as elapsed on every iteration
+            eraseAt(index);
+        } else if (mode == IChirpTimer::TimerMode::ONE_SHOT) {
+            // One-shot timers release themselves after firing
+            eraseAt(index);
+            timer->expire();
+        } else {
+            // Use its current firing time as the base for the next one
+            auto period = config ? config->period : timer->getDurationNs();
+            auto& firingTime = _heap[index].firingTime;
+            if (timer->getMissedTickPolicy() != IChirpTimer::MissedTickPolicy::CATCH_UP &&
+                period.count() > 0 && firingTime + period <= now) {
+                // Jump over every tick that is already due, keeping the alignment
+                firingTime += period * ((now - firingTime) / period);
             }
+            firingTime += period;
+            _heap[index].slack = timer->getSlack();
+            _heap[index].sequence = _nextSequence++;
+            siftDown(index);
+        }
+    }
+}
+
+bool TimerManager::getFiringTime(ChirpTimer* chirpTimer, std::chrono::steady_clock::time_point& firingTime) const {
+
+    size_t index = slotOf(chirpTimer);
+    if (index == ChirpTimer::NotScheduled) {
+        return false;
+    }
+    firingTime = _heap[index].firingTime;
+    return true;
+}
+
+void TimerManager::addDeferredMessage(Message* message) {
+
+    _deferred.push_back(DeferredEntry{message, message->getDueTime(), _nextSequence++});
+    std::push_heap(_deferred.begin(), _deferred.end(), later);
+}
+
+void TimerManager::getDueMessages(std::vector<Message*>& dueMessages) {
+
+    dueMessages.clear();
+    auto limit = ChirpClock::now();
+    while (!_deferred.empty() && _deferred.front().due <= limit) {
+        std::pop_heap(_deferred.begin(), _deferred.end(), later);
+        dueMessages.push_back(_deferred.back().message);
+        _deferred.pop_back();
+    }
+}
+
+void TimerManager::takeDeferredMessages(std::vector<Message*>& messages) {
+
+    messages.clear();
+    for (const DeferredEntry& entry : _deferred) {
+        messages.push_back(entry.message);
+    }
+    _deferred.clear();
+}
+
+size_t TimerManager::getDeferredMessageCount() const {
+
+    return _deferred.size();
+}
+
+size_t TimerManager::getTimerCount() const {
+
+    return _heap.size();
+}
+
+bool TimerManager::later(const DeferredEntry& a, const DeferredEntry& b) {
+
+    // std::push_heap builds a max-heap, so order by "due later" to keep the earliest on top
+    if (a.due != b.due) {
+        return a.due > b.due;
+    }
+    return a.sequence > b.sequence;
+}
+
+bool TimerManager::earlier(const HeapEntry& a, const HeapEntry& b) const {
+
+    if (a.firingTime != b.firingTime) {
+        return a.firingTime < b.firingTime;
+    }
+    return a.sequence < b.sequence;
+}
+
+void TimerManager::place(size_t index, HeapEntry entry) {
+
+    entry.timer->setHeapSlot(index);
+    _heap[index] = entry;
+}
+
+void TimerManager::siftUp(size_t index) {
+
+    HeapEntry entry = _heap[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!earlier(entry, _heap[parent])) {
+            break;
+        }
+        place(index, _heap[parent]);
+        index = parent;
+    }
+    place(index, entry);
+}
+
+void TimerManager::siftDown(size_t index) {
+
+    HeapEntry entry = _heap[index];
+    size_t count = _heap.size();
+    while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && earlier(_heap[child + 1], _heap[child])) {
+            child++;
         }
+        if (!earlier(_heap[child], entry)) {
+            break;
+        }
+        place(index, _heap[child]);
+        index = child;
+    }
+    place(index, entry);
+}
+
+void TimerManager::restore(size_t index) {
+
+    // The entry may need to move either way; sift up first, then down from wherever it landed
+    ChirpTimer* timer = _heap[index].timer;
+    siftUp(index);
+    siftDown(timer->heapSlot());
+}
+
+void TimerManager::eraseAt(size_t index) {
+
+    _heap[index].timer->setHeapSlot(ChirpTimer::NotScheduled);
+
+    size_t last = _heap.size() - 1;
+    if (index != last) {
+        // Move the last entry into the hole and restore heap order around it
+        place(index, _heap[last]);
+        _heap.pop_back();
+        restore(index);
+    } else {
+        _heap.pop_back();
     }
 }
 
+size_t TimerManager::slotOf(const ChirpTimer* timer) const {
+
+    // The slot is only ours if our heap holds the timer there
+    size_t index = timer->heapSlot();
+    if (index < _heap.size() && _heap[index].timer == timer) {
+        return index;
+    }
+    return ChirpTimer::NotScheduled;
+}
@@ -12,10 +12,22 @@
 #pragma once
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include "chirp_timer.h"
 
+class Message;
+
 /**
  * @brief Timer manager class for managing multiple timers
+ *
+ * Firing times are kept in an indexed binary min-heap. Each timer carries its
+ * own heap slot, so add, remove and reschedule cost O(log n), the
+ * next deadline is read in O(1), and collecting the k elapsed timers costs
+ * O(k) regardless of how many timers are armed.
+ *
+ * Messages posted with a delay wait in a second min-heap next to the timers.
+ * They need no handle, since they are never cancelled, and share the
+ * wakeup computed for the timers.
  */
 class TimerManager {
 public:
@@ -30,50 +42,40 @@ public:
     ~TimerManager();
 
     /**
-     * @brief Add a timer to the internal vector
+     * @brief Add a timer to the firing schedule
      * @param chirpTimer The timer to add
      * 
-     * Adds the provided ChirpTimer to the internal vector for management.
+     * Schedules the timer one duration from now. Adding a timer that is
+     * already scheduled moves its firing time instead of adding it twice.
      */
     void addTimer(ChirpTimer* chirpTimer);
 
     /**
-     * @brief Remove a timer from the internal vector
+     * @brief Remove a timer from the firing schedule
      * @param chirpTimer The timer to remove
      * 
-     * Removes the provided ChirpTimer from the internal vector.
-     * Also removes it from the firing times list if present.
+     * Does nothing if the timer is not scheduled.
      */
     void removeTimer(ChirpTimer* chirpTimer);
 
     /**
-     * @brief Compute next timer firing time for all timers
-     * 
-     * Creates a vector of all timer instances and calculates their next firing time.
-     * For first-time additions, reads start time and adds duration. Sorts the vector
-     * by firing time with lowest times at the top. Result is stored in _timerFiringTimes.
-     * Skips any timers that are in the elapsedTimers list.
-     * 
-     * @param elapsedTimers Vector of timers that have just elapsed and should be skipped
-     */
-    void computeNextTimerFirringTime();
-
-    /**
-     * @brief Get duration to wait before next timer event
-     * @return Duration in milliseconds to wait before the next timer fires
-     * 
-     * Calculates the time remaining until the next timer event by finding the
-     * lowest firing time in _timerFiringTimes and subtracting current time.
-     * Returns 0 if no timers are scheduled or if the next event is in the past.
+     * @brief Get the absolute time the loop should next wake up for timers
+     * @param firingTime Output parameter - end of the earliest slack window
+     * @return true if a timer or deferred message is scheduled, false otherwise
+     *
+     * Every timer may fire between its firing time and its firing time plus
+     * its slack. Deferred messages have no slack and are due at their due time. Waking at the end of the earliest window fires the largest
+     * batch without making any timer later than its slack allows. Without
+     * slack this is the earliest firing time.
      */
-    std::chrono::milliseconds getDurationToNextTimerEvent() const;
+    bool getNextTimerFiringTime(std::chrono::steady_clock::time_point& firingTime) const;
 
     /**
      * @brief Generate a list of timers that have elapsed
      * @param elapsedTimers Output parameter - vector to be populated with elapsed timers
      * 
-     * Compares the current time with _timerFiringTimes to identify timers that have elapsed.
-     * Populates the provided vector with pointers to timers that should fire now.
+     * Walks only the part of the heap that is due, and returns the timers
+     * ordered by firing time.
      */
     void getElapsedTimers(std::vector<ChirpTimer*>& elapsedTimers) const;
 
@@ -81,14 +83,98 @@ public:
      * @brief Reschedule specific timers that have fired
      * @param firedTimers Vector of timers that have just fired and need rescheduling
      * 
-     * For each timer in the list, removes its old firing time and calculates a new one
-     * based on the previous firing time plus the timer's duration.
+     * Each timer's next firing time is its previous firing time plus its
+     * duration. Timers that have been stopped are dropped from the firing schedule.
      */
     void rescheduleTimers(const std::vector<ChirpTimer*>& firedTimers);
 
+    /**
+     * @brief Reschedule fired timers relative to a given time
+     * @param firedTimers Vector of timers that have just fired and need rescheduling
+     * @param now Time the batch was dispatched at
+     *
+     * Timers whose missed-tick policy is not CATCH_UP skip the ticks that
+     * are already due at now and resume at the next aligned tick after it.
+     */
+    void rescheduleTimers(const std::vector<ChirpTimer*>& firedTimers,
+                          std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Get the scheduled firing time of one timer
+     * @param chirpTimer The timer to look up
+     * @param firingTime Output parameter for its firing time
+     * @return true if the timer is scheduled
+     */
+    bool getFiringTime(ChirpTimer* chirpTimer, std::chrono::steady_clock::time_point& firingTime) const;
+
+    /**
+     * @brief Hold a message back until its due time
+     * @param message The message, which must carry its due time
+     *
+     * Messages due at the same instant are released in the order they were added.
+     */
+    void addDeferredMessage(Message* message);
+
+    /**
+     * @brief Take the deferred messages that have become due
+     * @param dueMessages Output parameter - vector to be populated, ordered by due time
+     */
+    void getDueMessages(std::vector<Message*>& dueMessages);
+
+    /**
+     * @brief Take every deferred message, due or not
+     * @param messages Output parameter - vector to be populated
+     *
+     * Used to free the messages of a service that is being stopped.
+     */
+    void takeDeferredMessages(std::vector<Message*>& messages);
+
+    /**
+     * @brief Get the number of messages waiting for their due time
+     * @return Number of deferred messages
+     */
+    size_t getDeferredMessageCount() const;
+
+    /**
+     * @brief Get the number of scheduled timers
+     * @return Number of timers in the firing schedule
+     */
+    size_t getTimerCount() const;
+
 private:
-    std::vector<ChirpTimer*> _timers;  /**< Vector of timer pointers */
-    std::vector<std::pair<ChirpTimer*, std::chrono::steady_clock::time_point>> _timerFiringTimes;  /**< Vector of timer firing times */
-    std::chrono::steady_clock::time_point _nextFiringTime;  /**< Time point of the next timer to fire */
-    size_t _nextFirringTimerIndex;  /**< Index of the timer with the lowest firing time */
+    /**
+     * @brief One heap slot. Ties on firing time are broken by insertion
+     *        order, so timers due at the same instant always fire in the same order.
+     */
+    struct HeapEntry {
+        ChirpTimer* timer;
+        std::chrono::steady_clock::time_point firingTime;
+        std::chrono::nanoseconds slack;
+        uint64_t sequence;
+    };
+
+    /**
+     * @brief One deferred message. Ties on due time are broken by insertion order.
+     */
+    struct DeferredEntry {
+        Message* message;
+        std::chrono::steady_clock::time_point due;
+        uint64_t sequence;
+    };
+
+    static bool later(const DeferredEntry& a, const DeferredEntry& b);
+
+    bool earlier(const HeapEntry& a, const HeapEntry& b) const;
+    void place(size_t index, HeapEntry entry);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void restore(size_t index);
+    void eraseAt(size_t index);
+    size_t slotOf(const ChirpTimer* timer) const;  // ChirpTimer::NotScheduled if not in this heap
+
+    std::vector<HeapEntry> _heap;  /**< Min-heap of firing times */
+    std::vector<DeferredEntry> _deferred;  /**< Min-heap of deferred messages by due time */
+    uint64_t _nextSequence = 0;  /**< Insertion counter used as tie-breaker */
+    mutable std::vector<size_t> _walk;  /**< Scratch stack for heap walks, reused to avoid allocating */
+    mutable std::vector<const HeapEntry*> _due;  /**< Scratch list of due entries */
 };
@@ -7,6 +7,7 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <map>
 
 // Simple test framework for ChirpFactory tests
 class SimpleTestFramework {
@@ -399,6 +400,295 @@ void testChirpFactoryErrorHandling() {
 }
 
 // Main function for ChirpFactory tests
+class RecordingObserver : public IChirpFactoryObserver {
+public:
+    std::vector<std::string> created;
+    std::vector<std::string> destroyed;
+
+    void onServiceCreated(const std::string& service_name, IChirp* /*service*/) override {
+        created.push_back(service_name);
+    }
+    void onServiceDestroyed(const std::string& service_name, IChirp* /*service*/) override {
+        destroyed.push_back(service_name);
+    }
+};
+
+void testChirpFactoryObserver() {
+    testFramework.startTest("ChirpFactory_Observer_ReplaysAndTracksServices");
+
+    try {
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        factory.shutdownAllServices();
+
+        IChirp* service = nullptr;
+        factory.createService("ObservedBefore", &service);
+
+        RecordingObserver observer;
+        testFramework.assertTrue(factory.addObserver(&observer) == ChirpError::SUCCESS, "Adding an observer should succeed");
+        testFramework.assertTrue(factory.addObserver(&observer) == ChirpError::HANDLER_ALREADY_EXISTS,
+                                 "Adding an observer twice should fail");
+        testFramework.assertTrue(observer.created == std::vector<std::string>{"ObservedBefore"},
+                                 "Existing services should be replayed as created");
+
+        factory.createService("ObservedAfter", &service);
+        factory.destroyService("ObservedBefore");
+        testFramework.assertTrue(observer.created.size() == 2 && observer.created[1] == "ObservedAfter",
+                                 "New services should be reported");
+        testFramework.assertTrue(observer.destroyed == std::vector<std::string>{"ObservedBefore"},
+                                 "Destroyed services should be reported");
+
+        testFramework.assertTrue(factory.removeObserver(&observer) == ChirpError::SUCCESS, "Removing an observer should succeed");
+        factory.destroyService("ObservedAfter");
+        testFramework.assertTrue(observer.destroyed.size() == 1, "A removed observer should not be called");
+        testFramework.assertTrue(factory.removeObserver(&observer) == ChirpError::HANDLER_NOT_FOUND,
+                                 "Removing an unknown observer should fail");
+
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testChirpFactoryServiceRef() {
+    testFramework.startTest("ChirpFactory_ServiceRef_OutlivesDestroyAndConcurrentLookups");
+
+    try {
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        factory.shutdownAllServices();
+
+        IChirp* service = nullptr;
+        factory.createService("RefService", &service);
+        ChirpServiceRef ref = factory.getServiceRef("RefService");
+        ChirpServiceRef copy = ref;
+        testFramework.assertTrue(copy.get() == service, "The handle should point at the service");
+        testFramework.assertTrue(!factory.getServiceRef("NoSuchService"), "A missing service should give an empty handle");
+
+        // Lookups from many threads while other services come and go
+        std::atomic<bool> stop{false};
+        std::atomic<int> misses{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 8; ++t) {
+            readers.emplace_back([&]() {
+                while (!stop.load()) {
+                    if (factory.getService("RefService") != service) {
+                        misses++;
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 200; ++i) {
+            IChirp* churn = nullptr;
+            factory.createService("ChurnService", &churn);
+            factory.destroyService("ChurnService");
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        testFramework.assertTrue(misses.load() == 0, "A live service should always be found");
+
+        // The handle keeps the object valid after the factory lets go of it
+        factory.destroyService("RefService");
+        testFramework.assertTrue(factory.getService("RefService") == nullptr, "The destroyed service should be gone");
+        testFramework.assertTrue(copy->getServiceName() == "RefService", "The handle should keep the object alive");
+
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// Handler that keeps its service busy for a while
+class SleepingHandler {
+public:
+    void onWork(int millis) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+    }
+};
+
+void testChirpFactoryBulkLifecycle() {
+    testFramework.startTest("ChirpFactory_BulkLifecycle_ParallelShutdownWithDeadline");
+
+    try {
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        factory.shutdownAllServices();
+
+        SleepingHandler handler;
+        const int serviceCount = 20;
+        for (int i = 0; i < serviceCount; ++i) {
+            IChirp* service = nullptr;
+            factory.createService("BulkService" + std::to_string(i), &service);
+            service->registerMsgHandler("Work", &handler, &SleepingHandler::onWork);
+        }
+        IChirp* polled = nullptr;
+        factory.createService("BulkPolled", &polled);
+        testFramework.assertTrue(polled->start(IChirp::RunMode::POLLED) == ChirpError::SUCCESS, "Polled start should succeed");
+
+        std::vector<std::string> failed;
+        testFramework.assertTrue(factory.startAllServices(failed) == ChirpError::SUCCESS, "Bulk start should succeed");
+        testFramework.assertTrue(failed.empty(), "No service should fail to start");
+
+        // Every service is busy for 100ms; joined one after the other this would take 2s
+        for (int i = 0; i < serviceCount; ++i) {
+            factory.getService("BulkService" + std::to_string(i))->postMsg("Work", 100);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::vector<std::string> missed;
+        auto begin = std::chrono::steady_clock::now();
+        auto e = factory.shutdownAllServices(std::chrono::milliseconds(2000), missed);
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        testFramework.assertTrue(e == ChirpError::SUCCESS, "Every service should stop in time");
+        testFramework.assertTrue(missed.empty(), "No service should miss the deadline");
+        testFramework.assertTrue(elapsed < std::chrono::milliseconds(1000), "Services should be joined in parallel");
+        testFramework.assertTrue(factory.getServiceCount() == 0, "The registry should be empty");
+
+        // A stuck service is reported and the others are not held up by it
+        IChirp* stuck = nullptr;
+        IChirp* idle = nullptr;
+        factory.createService("BulkStuck", &stuck);
+        factory.createService("BulkIdle", &idle);
+        stuck->registerMsgHandler("Work", &handler, &SleepingHandler::onWork);
+        factory.startAllServices(failed);
+        stuck->postMsg("Work", 500);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        e = factory.shutdownAllServices(std::chrono::milliseconds(100), missed);
+        testFramework.assertTrue(e == ChirpError::TIMEOUT, "The stuck service should time out");
+testFramework.assertTrue(missed.size() == 1 && missed[0] == "BulkStuck", "Only the stuck service should be reported");
+        testFramework.assertTrue(factory.getService("BulkStuck") == nullptr, "The stuck service should leave the registry");
+
+        // Let the stuck service finish stopping in the background
+        std::this_thread::sleep_for(std::chrono::milliseconds(600));
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// Startup handler that records when it ran and how many ran at once
+class StartupRecorder {
+public:
+    ChirpError::Error onStartup() {
+        begin = std::chrono::steady_clock::now();
+        int now = ++active;
+        int seen = maxActive.load();
+        while (now > seen && !maxActive.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        --active;
+        end = std::chrono::steady_clock::now();
+        return ChirpError::SUCCESS;
+    }
+
+    std::chrono::steady_clock::time_point begin{};
+    std::chrono::steady_clock::time_point end{};
+    static inline std::atomic<int> active{0};
+    static inline std::atomic<int> maxActive{0};
+};
+
+void testChirpFactoryDependencyWaves() {
+    testFramework.startTest("ChirpFactory_DependencyWaves_StartInOrderAndInParallel");
+
+    try {
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        factory.shutdownAllServices();
+
+        // D needs B and C, which both need A
+        testFramework.assertTrue(factory.addDependency("WaveB", "WaveA") == ChirpError::SUCCESS, "B on A should be accepted");
+        testFramework.assertTrue(factory.addDependency("WaveC", "WaveA") == ChirpError::SUCCESS, "C on A should be accepted");
+        testFramework.assertTrue(factory.addDependency("WaveD", "WaveB") == ChirpError::SUCCESS, "D on B should be accepted");
+        testFramework.assertTrue(factory.addDependency("WaveD", "WaveC") == ChirpError::SUCCESS, "D on C should be accepted");
+        testFramework.assertTrue(factory.addDependency("WaveA", "WaveD") == ChirpError::INVALID_CONFIGURATION, "A cycle should be refused");
+        testFramework.assertTrue(factory.addDependency("WaveA", "WaveA") == ChirpError::INVALID_ARGUMENTS, "A self dependency should be refused");
+        testFramework.assertTrue(factory.addDependency("WaveE", "WaveGhost") == ChirpError::SUCCESS, "E on an unknown service should be accepted");
+
+        std::map<std::string, StartupRecorder> recorders;
+        for (const char* name : {"WaveA", "WaveB", "WaveC", "WaveD", "WaveE"}) {
+            IChirp* service = nullptr;
+            factory.createService(name, &service);
+            service->registerMsgHandler(IChirpFactory::StartupMessage, &recorders[name], &StartupRecorder::onStartup);
+        }
+
+        std::vector<std::string> failed;
+        auto e = factory.startAllServices(failed);
+        testFramework.assertTrue(e == ChirpError::SERVICE_NOT_FOUND, "The missing dependency should be reported");
+        testFramework.assertTrue(failed.size() == 1 && failed[0] == "WaveE", "Only E should fail to start");
+
+        auto& a = recorders["WaveA"];
+        auto& b = recorders["WaveB"];
+        auto& c = recorders["WaveC"];
+        auto& d = recorders["WaveD"];
+        testFramework.assertTrue(b.begin >= a.end && c.begin >= a.end, "B and C should start after A is up");
+        testFramework.assertTrue(d.begin >= b.end && d.begin >= c.end, "D should start after B and C are up");
+        testFramework.assertTrue(StartupRecorder::maxActive.load() >= 2, "B and C should start in parallel");
+        testFramework.assertTrue(recorders["WaveE"].begin == std::chrono::steady_clock::time_point{}, "E should not be started");
+
+        testFramework.assertTrue(factory.removeDependency("WaveD", "WaveA") == ChirpError::SERVICE_NOT_FOUND, "An undeclared dependency cannot be removed");
+        factory.removeDependency("WaveB", "WaveA");
+        factory.removeDependency("WaveC", "WaveA");
+        factory.removeDependency("WaveD", "WaveB");
+        factory.removeDependency("WaveD", "WaveC");
+        factory.removeDependency("WaveE", "WaveGhost");
+        factory.shutdownAllServices();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testChirpFactoryContexts() {
+    testFramework.startTest("ChirpFactory_Contexts_IndependentRegistriesAndShutdownScope");
+
+    try {
+        IChirpFactory& defaultFactory = IChirpFactory::getInstance();
+        defaultFactory.shutdownAllServices();
+
+        IChirpFactory* first = IChirpFactory::createFactory();
+        IChirpFactory* second = IChirpFactory::createFactory();
+        testFramework.assertTrue(first && second && first != second, "Each call should give a new context");
+        testFramework.assertTrue(first != &defaultFactory, "A context should not be the default one");
+
+        // The same name lives independently in every context
+        IChirp* firstService = nullptr;
+        IChirp* secondService = nullptr;
+        testFramework.assertTrue(first->createService("ContextService", &firstService) == ChirpError::SUCCESS, "First context should create the service");
+        testFramework.assertTrue(second->createService("ContextService", &secondService) == ChirpError::SUCCESS, "Second context should create the same name");
+        testFramework.assertTrue(firstService != secondService, "The two services should be distinct");
+        testFramework.assertTrue(defaultFactory.getService("ContextService") == nullptr, "The default context should not see them");
+        testFramework.assertTrue(defaultFactory.getServiceCount() == 0, "The default context should stay empty");
+
+        // Alternating lookups from several threads find each context's own service
+        std::atomic<int> misses{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&]() {
+                for (int i = 0; i < 1000; ++i) {
+                    if (first->getService("ContextService") != firstService ||
+                        second->getService("ContextService") != secondService ||
+                        defaultFactory.getService("ContextService") != nullptr) {
+                        misses++;
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        testFramework.assertTrue(misses.load() == 0, "Lookups should never cross contexts");
+
+        // Deleting a context shuts down what it still holds
+        firstService->start();
+        ChirpServiceRef ref = first->getServiceRef("ContextService");
+        delete first;
+        testFramework.assertTrue(ref->postMsg("Anything") != ChirpError::SUCCESS, "The service should be shut down with its context");
+        testFramework.assertTrue(second->getService("ContextService") == secondService, "The other context should be untouched");
+
+        delete second;
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
 int main() {
     std::cout << "Starting ChirpFactory Tests\n";
     std::cout << "===========================\n\n";
@@ -422,6 +712,11 @@ int main() {
         testChirpFactoryMultipleServices();
         testChirpFactoryServiceLifecycle();
         testChirpFactoryErrorHandling();
+        testChirpFactoryObserver();
+        testChirpFactoryServiceRef();
+        testChirpFactoryBulkLifecycle();
+        testChirpFactoryDependencyWaves();
+        testChirpFactoryContexts();
     } catch (const std::exception& e) {
         std::cout << "Test execution failed: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,332 @@
+/**
+ * Unit tests for ichirp_pipeline.h
+ * Framework: Custom Simple Test Framework
+ */
+
+#include "ichirp_pipeline.h"
+#include "ichirp_factory.h"
+#include "chirp_error.h"
+#include <any>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+// Simple test framework without external dependencies
+class SimpleTestFramework {
+private:
+    int totalTests = 0;
+    int passedTests = 0;
+    int failedTests = 0;
+    std::string currentTestName;
+
+public:
+    void startTest(const std::string& testName) {
+        currentTestName = testName;
+        totalTests++;
+        std::cout << "Running: " << testName << std::endl;
+    }
+
+    void endTest(bool passed) {
+        if (passed) {
+            passedTests++;
+            std::cout << "✓ PASSED: " << currentTestName << std::endl;
+        } else {
+            failedTests++;
+            std::cout << "✗ FAILED: " << currentTestName << std::endl;
+        }
+    }
+
+    void assertTrue(bool condition, const std::string& message = "") {
+        if (!condition) {
+            std::cout << "  Assertion failed: " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertFalse(bool condition, const std::string& message = "") {
+        if (condition) {
+            std::cout << "  Assertion failed: " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(int expected, int actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected " << expected << " but got " << actual << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(const std::string& expected, const std::string& actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected '" << expected << "' but got '" << actual << "': " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(ChirpError::Error expected, ChirpError::Error actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected error " << static_cast<int>(expected) 
+                      << " but got " << static_cast<int>(actual) << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertNoThrow(std::function<void()> func, const std::string& message = "") {
+        try {
+            func();
+        } catch (const std::exception& e) {
+            std::cout << "  Exception thrown: " << e.what() << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void printSummary() {
+        std::cout << "\n=== ChirpPipeline Test Summary ===" << std::endl;
+        std::cout << "Total Tests: " << totalTests << std::endl;
+        std::cout << "Passed: " << passedTests << std::endl;
+        std::cout << "Failed: " << failedTests << std::endl;
+
+        if (failedTests == 0) {
+            std::cout << "🎉 All ChirpPipeline tests passed!" << std::endl;
+        }
+    }
+
+    int getFailedTests() const { return failedTests; }
+};
+
+// Stage objects used by the tests
+class Doubler {
+public:
+    ChirpError::Error process(std::any& item) {
+        item = std::any_cast<int>(item) * 2;
+        return ChirpError::SUCCESS;
+    }
+};
+
+class OddFilter {
+public:
+    ChirpError::Error process(std::any& item) {
+        return (std::any_cast<int>(item) % 2 == 0) ? ChirpError::SUCCESS : ChirpError::INVALID_MESSAGE;
+    }
+};
+
+class Gate {
+public:
+    std::atomic<bool> open{true};
+
+    ChirpError::Error process(std::any& /*item*/) {
+        while (!open.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return ChirpError::SUCCESS;
+    }
+};
+
+class Collector {
+public:
+    std::mutex mtx;
+    std::vector<int> items;
+
+    ChirpError::Error process(std::any& item) {
+        std::lock_guard<std::mutex> lock(mtx);
+        items.push_back(std::any_cast<int>(item));
+        return ChirpError::SUCCESS;
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return items.size();
+    }
+};
+
+// Push with retry, since push() reports NO_CREDIT instead of blocking
+static void pushAll(IChirpPipeline* pipeline, int from, int to) {
+    for (int i = from; i < to; ++i) {
+        while (pipeline->push(i) == ChirpError::NO_CREDIT) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
+static bool waitForCount(Collector& collector, size_t expected) {
+    for (int i = 0; i < 5000 && collector.count() < expected; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return collector.count() == expected;
+}
+
+// Global test framework instance
+SimpleTestFramework testFramework;
+
+// ===== IChirpPipeline TESTS =====
+
+void testPipeline_ItemsFlowThroughStagesInOrder() {
+    testFramework.startTest("ChirpPipeline_push_ItemsFlowThroughStagesInOrder");
+
+    IChirpPipeline* pipeline = IChirpPipeline::createPipeline(&IChirpFactory::getInstance());
+
+    try {
+        Doubler doubler;
+        Collector collector;
+        pipeline->addStage("PipeDouble", &doubler, &Doubler::process, 8);
+        pipeline->addStage("PipeCollect", &collector, &Collector::process, 8);
+
+        testFramework.assertEquals(ChirpError::SUCCESS, pipeline->start(), "Pipeline should start");
+        pushAll(pipeline, 0, 1000);
+
+        testFramework.assertTrue(waitForCount(collector, 1000), "All items should reach the last stage");
+        bool ordered = true;
+        for (int i = 0; i < 1000; ++i) {
+            ordered = ordered && (collector.items[i] == i * 2);
+        }
+        testFramework.assertTrue(ordered, "Items should arrive transformed and in order");
+
+        pipeline->stop();
+        testFramework.endTest(true);
+    } catch (...) {
+        pipeline->stop();
+        testFramework.endTest(false);
+    }
+    delete pipeline;
+}
+
+void testPipeline_SlowStage_ThrottlesProducer() {
+    testFramework.startTest("ChirpPipeline_push_SlowStageThrottlesProducer");
+
+    IChirpPipeline* pipeline = IChirpPipeline::createPipeline(&IChirpFactory::getInstance());
+
+    try {
+        Doubler doubler;
+        Gate gate;
+        Collector collector;
+        pipeline->addStage("PipeFast", &doubler, &Doubler::process, 4);
+        pipeline->addStage("PipeSlow", &gate, &Gate::process, 4);
+        pipeline->addStage("PipeSink", &collector, &Collector::process, 4);
+
+        gate.open = false;
+        pipeline->start();
+
+        int accepted = 0;
+        for (int i = 0; i < 1000; ++i) {
+            if (pipeline->push(i) == ChirpError::SUCCESS) {
+                accepted++;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        // Two full rings, plus one item held in each stage upstream of the gate
+        testFramework.assertTrue(accepted <= 4 + 4 + 2, "Producer should run out of credit behind a stalled stage");
+
+        std::vector<PipelineStageStats> stats;
+        pipeline->getStageStats(stats);
+        testFramework.assertEquals(3, static_cast<int>(stats.size()), "One stats entry per stage");
+        testFramework.assertEquals(4, static_cast<int>(stats[0].occupancy), "First ring should be full");
+        testFramework.assertEquals(4, static_cast<int>(stats[0].capacity), "Capacity is the credit limit");
+
+        gate.open = true;
+        testFramework.assertTrue(waitForCount(collector, accepted), "Accepted items should drain once the stage recovers");
+        pushAll(pipeline, 0, 100);
+        testFramework.assertTrue(waitForCount(collector, accepted + 100), "Producer should regain credit");
+
+        pipeline->stop();
+        testFramework.endTest(true);
+    } catch (...) {
+        pipeline->stop();
+        testFramework.endTest(false);
+    }
+    delete pipeline;
+}
+
+void testPipeline_Stats_CountProcessedAndDropped() {
+    testFramework.startTest("ChirpPipeline_getStageStats_CountsProcessedAndDropped");
+
+    IChirpPipeline* pipeline = IChirpPipeline::createPipeline(&IChirpFactory::getInstance());
+
+    try {
+        OddFilter filter;
+        Collector collector;
+        pipeline->addStage("PipeFilter", &filter, &OddFilter::process, 16);
+        pipeline->addStage("PipeKeep", &collector, &Collector::process, 16);
+        pipeline->start();
+
+        pushAll(pipeline, 0, 100);
+        testFramework.assertTrue(waitForCount(collector, 50), "Only even items should pass the filter");
+
+        // The last item is odd, so the filter may still be handling it
+        std::vector<PipelineStageStats> stats;
+        pipeline->getStageStats(stats);
+        for (int i = 0; i < 5000 && stats[0].processed < 100; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            pipeline->getStageStats(stats);
+        }
+        testFramework.assertEquals("PipeFilter", stats[0].name, "Stats should be in pipeline order");
+        testFramework.assertEquals(100, static_cast<int>(stats[0].processed), "Filter should see every item");
+        testFramework.assertEquals(50, static_cast<int>(stats[0].dropped), "Rejected items should count as dropped");
+        testFramework.assertEquals(50, static_cast<int>(stats[1].processed), "Sink should see the forwarded items");
+        testFramework.assertTrue(stats[1].itemsPerSecond > 0.0, "Throughput should be reported");
+
+        pipeline->stop();
+        testFramework.endTest(true);
+    } catch (...) {
+        pipeline->stop();
+        testFramework.endTest(false);
+    }
+    delete pipeline;
+}
+
+void testPipeline_InvalidUsage_ReturnsErrors() {
+    testFramework.startTest("ChirpPipeline_InvalidUsage_ReturnsErrors");
+
+    IChirpPipeline* pipeline = IChirpPipeline::createPipeline(&IChirpFactory::getInstance());
+
+    try {
+        Collector collector;
+        testFramework.assertEquals(ChirpError::INVALID_CONFIGURATION, pipeline->start(), "Empty pipeline should not start");
+        testFramework.assertEquals(ChirpError::INVALID_SERVICE_STATE, pipeline->push(1), "Push before start should fail");
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   pipeline->addStage("PipeZero", &collector, &Collector::process, 0),
+                                   "Zero capacity should be rejected");
+
+        pipeline->addStage("PipeOnly", &collector, &Collector::process, 2);
+        testFramework.assertEquals(ChirpError::SERVICE_ALREADY_EXISTS,
+                                   pipeline->addStage("PipeOnly", &collector, &Collector::process, 2),
+                                   "Stage names should be unique");
+        pipeline->start();
+        testFramework.assertEquals(ChirpError::INVALID_SERVICE_STATE,
+                                   pipeline->addStage("PipeLate", &collector, &Collector::process, 2),
+                                   "Stages cannot be added while running");
+
+        pipeline->stop();
+        testFramework.assertTrue(IChirpFactory::getInstance().getService("PipeOnly") == nullptr,
+                                 "Stop should destroy the stage services");
+        testFramework.endTest(true);
+    } catch (...) {
+        pipeline->stop();
+        testFramework.endTest(false);
+    }
+    delete pipeline;
+}
+
+int main() {
+    std::cout << "=== ChirpPipeline Unit Tests ===" << std::endl;
+
+    testPipeline_ItemsFlowThroughStagesInOrder();
+    testPipeline_SlowStage_ThrottlesProducer();
+    testPipeline_Stats_CountProcessedAndDropped();
+    testPipeline_InvalidUsage_ReturnsErrors();
+
+    testFramework.printSummary();
+    return testFramework.getFailedTests() > 0 ? 1 : 0;
+}
@@ -0,0 +1,367 @@
+/**
+ * Unit tests for ichirp_simulation.h
+ * Framework: Custom Simple Test Framework
+ */
+
+#include "ichirp_simulation.h"
+#include "ichirp_watchdog.h"
+#include "ichirp_factory.h"
+#include "ichirp.h"
+#include "ichirp_timer.h"
+#include "chirp_error.h"
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <algorithm>
+
+// Simple test framework without external dependencies
+class SimpleTestFramework {
+private:
+    int totalTests = 0;
+    int passedTests = 0;
+    int failedTests = 0;
+    std::string currentTestName;
+
+public:
+    void startTest(const std::string& testName) {
+        currentTestName = testName;
+        totalTests++;
+        std::cout << "Running: " << testName << std::endl;
+    }
+
+    void endTest(bool passed) {
+        if (passed) {
+            passedTests++;
+            std::cout << "✓ PASSED: " << currentTestName << std::endl;
+        } else {
+            failedTests++;
+            std::cout << "✗ FAILED: " << currentTestName << std::endl;
+        }
+    }
+
+    void assertTrue(bool condition, const std::string& message = "") {
+        if (!condition) {
+            std::cout << "  Assertion failed: " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertFalse(bool condition, const std::string& message = "") {
+        if (condition) {
+            std::cout << "  Assertion failed: " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(int expected, int actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected " << expected << " but got " << actual << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(const std::string& expected, const std::string& actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected '" << expected << "' but got '" << actual << "': " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertEquals(ChirpError::Error expected, ChirpError::Error actual, const std::string& message = "") {
+        if (expected != actual) {
+            std::cout << "  Expected error " << static_cast<int>(expected) 
+                      << " but got " << static_cast<int>(actual) << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void assertNoThrow(std::function<void()> func, const std::string& message = "") {
+        try {
+            func();
+        } catch (const std::exception& e) {
+            std::cout << "  Exception thrown: " << e.what() << ": " << message << std::endl;
+            endTest(false);
+            throw std::runtime_error("Test failed: " + message);
+        }
+    }
+
+    void printSummary() {
+        std::cout << "\n=== ChirpSimulation Test Summary ===" << std::endl;
+        std::cout << "Total Tests: " << totalTests << std::endl;
+        std::cout << "Passed: " << passedTests << std::endl;
+        std::cout << "Failed: " << failedTests << std::endl;
+
+        if (failedTests == 0) {
+            std::cout << "🎉 All ChirpSimulation tests passed!" << std::endl;
+        }
+    }
+
+    int getFailedTests() const { return failedTests; }
+};
+
+// Records every timer or message it sees, in dispatch order
+class SimRecorder {
+public:
+    std::vector<std::string> events;
+    int timerCount = 0;
+    int missedPets = 0;
+
+    ChirpError::Error onTimer(const std::string& timerMsg) {
+        timerCount++;
+        events.push_back(timerMsg);
+        return ChirpError::SUCCESS;
+    }
+
+    void onMessage(std::string text) {
+        events.push_back(text);
+    }
+
+    void onMissedPet(const std::string& /*serviceName*/) {
+        missedPets++;
+    }
+};
+
+// Global test framework instance
+SimpleTestFramework testFramework;
+
+// ===== IChirpSimulation TESTS =====
+
+void testSimulation_RunFor_FiresTimersWithoutRealWaiting() {
+    testFramework.startTest("ChirpSimulation_runFor_OneHourOfTimerTicksInstantly");
+
+    IChirpFactory& factory = IChirpFactory::getInstance();
+    IChirpSimulation* sim = IChirpSimulation::createSimulation(&factory);
+    IChirpTimer* timer = IChirpTimer::createTimer();
+
+    try {
+        IChirp* service = nullptr;
+        factory.createService("SimTimerService", &service);
+        SimRecorder recorder;
+        service->registerMsgHandler("SimTick", &recorder, &SimRecorder::onTimer);
+
+        testFramework.assertEquals(ChirpError::SUCCESS, sim->start(), "Simulation should start");
+
+        timer->configure("SimTick", std::chrono::milliseconds(100));
+        timer->start();
+        service->addChirpTimer(timer);
+
+        auto realStart = std::chrono::steady_clock::now();
+        sim->runFor(std::chrono::hours(1));
+        auto realElapsed = std::chrono::steady_clock::now() - realStart;
+
+        testFramework.assertEquals(36000, recorder.timerCount, "A 100ms timer should fire 36000 times in an hour");
+        testFramework.assertTrue(sim->elapsed() == std::chrono::hours(1), "Virtual time should advance by exactly one hour");
+        testFramework.assertTrue(realElapsed < std::chrono::seconds(30), "Simulation should not wait in real time");
+
+        timer->stop();
+        service->removeChirpTimer(timer);
+        sim->stop();
+        factory.destroyService("SimTimerService");
+        testFramework.endTest(true);
+    } catch (...) {
+        sim->stop();
+        factory.destroyService("SimTimerService");
+        testFramework.endTest(false);
+    }
+    delete timer;
+    delete sim;
+}
+
+void testSimulation_RunUntilIdle_InterleavesServicesInNameOrder() {
+    testFramework.startTest("ChirpSimulation_runUntilIdle_DeterministicRoundRobin");
+
+    IChirpFactory& factory = IChirpFactory::getInstance();
+    std::vector<std::string> runs[2];
+
+    try {
+        for (auto& run : runs) {
+            IChirp* beta = nullptr;
+            IChirp* alpha = nullptr;
+            factory.createService("SimBeta", &beta);
+            factory.createService("SimAlpha", &alpha);
+
+            SimRecorder recorder;
+            alpha->registerMsgHandler("Note", &recorder, &SimRecorder::onMessage);
+            beta->registerMsgHandler("Note", &recorder, &SimRecorder::onMessage);
+
+            IChirpSimulation* sim = IChirpSimulation::createSimulation(&factory);
+            sim->start();
+
+            beta->postMsg("Note", std::string("b1"));
+            beta->postMsg("Note", std::string("b2"));
+            alpha->postMsg("Note", std::string("a1"));
+
+            size_t dispatched = sim->runUntilIdle();
+            testFramework.assertEquals(3, static_cast<int>(dispatched), "All queued messages should be dispatched");
+            run = recorder.events;
+
+            sim->stop();
+            delete sim;
+            factory.destroyService("SimAlpha");
+            factory.destroyService("SimBeta");
+        }
+
+        std::vector<std::string> expected = {"a1", "b1", "b2"};
+        testFramework.assertTrue(runs[0] == expected, "Services should be polled in name order, one message per round");
+        testFramework.assertTrue(runs[0] == runs[1], "Repeated runs should dispatch identically");
+        testFramework.endTest(true);
+    } catch (...) {
+        factory.destroyService("SimAlpha");
+        factory.destroyService("SimBeta");
+        testFramework.endTest(false);
+    }
+}
+
+void testSimulation_Attach_ThreadedService_ReturnsInvalidState() {
+    testFramework.startTest("ChirpSimulation_attach_ThreadedService_ReturnsInvalidState");
+
+    IChirpSimulation* sim = IChirpSimulation::createSimulation(&IChirpFactory::getInstance());
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp threaded("SimThreaded", error);
+        threaded.start();
+
+        testFramework.assertEquals(ChirpError::INVALID_SERVICE_STATE, sim->attach(&threaded),
+                                   "A service with its own thread cannot be simulated");
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS, sim->attach(nullptr),
+                                   "Null service should be rejected");
+
+        threaded.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+    delete sim;
+}
+
+void testSimulation_Watchdog_HealthyServicesNeverMissPets() {
+    testFramework.startTest("ChirpSimulation_Watchdog_HealthyServicesNeverMissPets");
+
+    IChirpFactory& factory = IChirpFactory::getInstance();
+    IChirpSimulation* sim = IChirpSimulation::createSimulation(&factory);
+    IChirpWatchDog* watchdog = IChirpWatchDog::createWatchdog("SimWatchdog");
+
+    try {
+        IChirp* service = nullptr;
+        factory.createService("SimMonitored", &service);
+        service->setWatchDogMonitoring(true);
+
+        SimRecorder recorder;
+        watchdog->getChirpService()->registerMsgHandler(IChirpWatchDog::MissedPetMessage,
+                                                        &recorder, &SimRecorder::onMissedPet);
+        watchdog->configure(&factory, std::chrono::milliseconds(500));
+
+        testFramework.assertEquals(ChirpError::SUCCESS, sim->start(), "Simulation should start");
+        testFramework.assertEquals(ChirpError::SUCCESS, sim->attach(watchdog->getChirpService()),
+                                   "Watchdog service should attach");
+        testFramework.assertEquals(ChirpError::SUCCESS, watchdog->start(),
+                                   "Watchdog should start on an already polled service");
+
+        sim->runFor(std::chrono::hours(2));
+        testFramework.assertEquals(0, recorder.missedPets, "Pets are never late under virtual time");
+
+        watchdog->stop();
+        sim->stop();
+        factory.destroyService("SimMonitored");
+        testFramework.endTest(true);
+    } catch (...) {
+        sim->stop();
+        factory.destroyService("SimMonitored");
+        testFramework.endTest(false);
+    }
+    delete watchdog;
+    delete sim;
+}
+
+// Runs a 10ms and a 13ms timer for 100ms of virtual time and returns the service counters
+static ChirpServiceStats runTwoTimers(IChirpFactory& factory, std::chrono::nanoseconds slack,
+                                      std::chrono::nanoseconds& maxLateness) {
+
+    IChirpSimulation* sim = IChirpSimulation::createSimulation(&factory);
+    IChirpTimer* fast = IChirpTimer::createTimer();
+    IChirpTimer* slow = IChirpTimer::createTimer();
+
+    IChirp* service = nullptr;
+    factory.createService("SimSlackService", &service);
+    SimRecorder recorder;
+    service->registerMsgHandler("Fast", &recorder, &SimRecorder::onTimer);
+    service->registerMsgHandler("Slow", &recorder, &SimRecorder::onTimer);
+    sim->start();
+
+    fast->configure("Fast", std::chrono::milliseconds(10));
+    slow->configure("Slow", std::chrono::milliseconds(13));
+    fast->setSlack(slack);
+    slow->setSlack(slack);
+    fast->start();
+    slow->start();
+    service->addChirpTimer(fast);
+    service->addChirpTimer(slow);
+
+    sim->runFor(std::chrono::milliseconds(100));
+
+    ChirpServiceStats stats;
+    service->getServiceStats(stats);
+    TimerLatenessStats fastLateness;
+    TimerLatenessStats slowLateness;
+    fast->getLatenessStats(fastLateness);
+    slow->getLatenessStats(slowLateness);
+    maxLateness = std::max(fastLateness.max, slowLateness.max);
+
+    fast->stop();
+    slow->stop();
+    service->removeChirpTimer(fast);
+    service->removeChirpTimer(slow);
+    sim->stop();
+    factory.destroyService("SimSlackService");
+    delete fast;
+    delete slow;
+    delete sim;
+    return stats;
+}
+
+void testSimulation_TimerSlack_CoalescesWakeups() {
+    testFramework.startTest("ChirpSimulation_TimerSlack_CoalescesWakeups");
+
+    IChirpFactory& factory = IChirpFactory::getInstance();
+
+    try {
+        std::chrono::nanoseconds maxLateness{};
+        ChirpServiceStats exact = runTwoTimers(factory, std::chrono::nanoseconds(0), maxLateness);
+        testFramework.assertEquals(17, static_cast<int>(exact.timersFired), "10 fast and 7 slow ticks in 100ms");
+        testFramework.assertEquals(17, static_cast<int>(exact.timerBatches),
+                                   "Without slack no two ticks share a wakeup");
+        testFramework.assertTrue(maxLateness == std::chrono::nanoseconds(0), "Without slack timers fire on time");
+
+        ChirpServiceStats slack = runTwoTimers(factory, std::chrono::milliseconds(5), maxLateness);
+        testFramework.assertEquals(17, static_cast<int>(slack.timersFired), "Slack must not drop ticks");
+        testFramework.assertEquals(10, static_cast<int>(slack.timerBatches),
+                                   "Ticks with overlapping windows should share a wakeup");
+        testFramework.assertTrue(maxLateness == std::chrono::milliseconds(5),
+                                 "No timer should fire later than its slack");
+        testFramework.endTest(true);
+    } catch (...) {
+        factory.destroyService("SimSlackService");
+        testFramework.endTest(false);
+    }
+}
+
+int main() {
+    std::cout << "=== ChirpSimulation Unit Tests ===" << std::endl;
+
+    testSimulation_RunFor_FiresTimersWithoutRealWaiting();
+    testSimulation_RunUntilIdle_InterleavesServicesInNameOrder();
+    testSimulation_Attach_ThreadedService_ReturnsInvalidState();
+    testSimulation_Watchdog_HealthyServicesNeverMissPets();
+    testSimulation_TimerSlack_CoalescesWakeups();
+
+    testFramework.printSummary();
+    return testFramework.getFailedTests() > 0 ? 1 : 0;
+}
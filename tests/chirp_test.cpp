@@ -8,8 +8,10 @@
 #include "chirp_error.h"
 #include "message.h"
 #include "chirp_logger.h"
+#include "chirp_clock.h"
 #include <memory>
 #include <vector>
+#include <map>
 #include <string>
 #include <thread>
 #include <chrono>
@@ -23,6 +25,8 @@
 #include <chrono>
 #include <thread>
 #include <limits>
+#include <poll.h>
+#include <unistd.h>
 
 // Temporary alias to maintain backward-compatible test code
 using Chirp = IChirp;
@@ -2018,6 +2022,560 @@ void testSimpleMessagePerformance() {
 // Duplicate message test functions removed - they already exist in the main test file
 
 // Main function to run all tests
+// ===== POLLED RUN MODE TESTS =====
+
+void testPolledMode_PollDispatchesOnCallerThread() {
+    testFramework.startTest("PolledMode_Poll_DispatchesOnCallerThreadWithinBudget");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("PolledService", error);
+        TestMessageHandler handler;
+        chirp.registerMsgHandler("PollMsg", &handler, &TestMessageHandler::handleInt);
+
+        testFramework.assertTrue(chirp.start(IChirp::RunMode::POLLED) == ChirpError::SUCCESS,
+                                 "Polled start should succeed");
+        for (int i = 0; i < 5; ++i) {
+            chirp.postMsg("PollMsg", i);
+        }
+        testFramework.assertEquals(0, handler.callCount, "Nothing should run before poll()");
+
+        size_t dispatched = 0;
+        chirp.poll(3, &dispatched);
+        testFramework.assertEquals(3, static_cast<int>(dispatched), "Poll should honour the budget");
+        testFramework.assertEquals(3, handler.callCount, "Handlers should run inline");
+
+        chirp.poll(100, &dispatched);
+        testFramework.assertEquals(2, static_cast<int>(dispatched), "Second poll should drain the rest");
+        testFramework.assertEquals(5, handler.callCount, "All messages should be dispatched");
+
+        chirp.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testPolledMode_PollFdSignalsWork() {
+    testFramework.startTest("PolledMode_GetPollFd_ReadableOnlyWithPendingWork");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("PolledFdService", error);
+        TestMessageHandler handler;
+        chirp.registerMsgHandler("PollMsg", &handler, &TestMessageHandler::handleInt);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        int fd = chirp.getPollFd();
+        testFramework.assertTrue(fd >= 0, "Polled service should expose a descriptor");
+
+        struct pollfd pfd = {fd, POLLIN, 0};
+        testFramework.assertEquals(0, ::poll(&pfd, 1, 0), "Descriptor should be idle with no work");
+
+        chirp.postMsg("PollMsg", 7);
+        testFramework.assertEquals(1, ::poll(&pfd, 1, 1000), "Descriptor should be readable after a post");
+
+        chirp.poll(10);
+        testFramework.assertEquals(1, handler.callCount, "Message should be dispatched");
+        testFramework.assertEquals(0, ::poll(&pfd, 1, 0), "Descriptor should be idle after draining");
+
+        size_t dispatched = 0;
+        chirp.postMsg("PollMsg", 8);
+        chirp.runFor(std::chrono::milliseconds(20), &dispatched);
+        testFramework.assertEquals(1, static_cast<int>(dispatched), "runFor should dispatch pending work");
+
+        chirp.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testPolledMode_PollOnThreadedService_ReturnsInvalidState() {
+    testFramework.startTest("PolledMode_PollOnThreadedService_ReturnsInvalidServiceState");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("ThreadedService", error);
+        chirp.start();
+
+        testFramework.assertTrue(chirp.poll(1) == ChirpError::INVALID_SERVICE_STATE,
+                                 "poll() requires RunMode::POLLED");
+        testFramework.assertTrue(chirp.start(IChirp::RunMode::POLLED) == ChirpError::SERVICE_ALREADY_STARTED,
+                                 "A running service cannot be started again");
+
+        chirp.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// ===== FILE DESCRIPTOR HANDLER TESTS =====
+
+class PipeReader {
+public:
+    std::atomic<int> bytesRead{0};
+    std::thread::id handlerThread;
+
+    void onReadable(int fd, uint32_t events) {
+        handlerThread = std::this_thread::get_id();
+        char buf[64];
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n > 0 && (events & IChirp::FD_READABLE)) {
+            bytesRead += static_cast<int>(n);
+        }
+    }
+};
+
+void testFdHandler_PipeReadiness_DispatchedOnServiceThread() {
+    testFramework.startTest("FdHandler_PipeReadiness_DispatchedOnServiceThread");
+
+    int fds[2] = {-1, -1};
+    try {
+        testFramework.assertTrue(::pipe(fds) == 0, "pipe() should succeed");
+
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("FdService", error);
+        PipeReader reader;
+        testFramework.assertTrue(chirp.registerFdHandler(fds[0], IChirp::FD_READABLE, &reader,
+                                                         &PipeReader::onReadable) == ChirpError::SUCCESS,
+                                 "Registering a pipe should succeed");
+        testFramework.assertTrue(chirp.registerFdHandler(fds[0], IChirp::FD_READABLE, &reader,
+                                                         &PipeReader::onReadable) == ChirpError::HANDLER_ALREADY_EXISTS,
+                                 "Duplicate registration should be rejected");
+        chirp.start();
+
+        testFramework.assertTrue(::write(fds[1], "hello", 5) == 5, "write() should succeed");
+        for (int i = 0; i < 100 && reader.bytesRead < 5; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        testFramework.assertEquals(5, reader.bytesRead.load(), "Handler should consume the pipe data");
+        testFramework.assertTrue(reader.handlerThread != std::this_thread::get_id(),
+                                 "Handler should run on the service thread");
+
+        testFramework.assertTrue(chirp.unregisterFdHandler(fds[0]) == ChirpError::SUCCESS,
+                                 "Unregister should succeed");
+        testFramework.assertTrue(chirp.unregisterFdHandler(fds[0]) == ChirpError::HANDLER_NOT_FOUND,
+                                 "Second unregister should report not found");
+        chirp.shutdown();
+        ::close(fds[0]);
+        ::close(fds[1]);
+        testFramework.endTest(true);
+    } catch (...) {
+        if (fds[0] >= 0) { ::close(fds[0]); ::close(fds[1]); }
+        testFramework.endTest(false);
+    }
+}
+
+void testFdHandler_InvalidDescriptor_ReturnsInvalidArguments() {
+    testFramework.startTest("FdHandler_InvalidDescriptor_ReturnsInvalidArguments");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("FdInvalidService", error);
+        PipeReader reader;
+        testFramework.assertTrue(chirp.registerFdHandler(-1, IChirp::FD_READABLE, &reader,
+                                                         &PipeReader::onReadable) == ChirpError::INVALID_ARGUMENTS,
+                                 "Negative descriptor should be rejected");
+        testFramework.assertTrue(chirp.registerFdHandler(0, 0, &reader,
+                                                         &PipeReader::onReadable) == ChirpError::INVALID_ARGUMENTS,
+                                 "Empty event mask should be rejected");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// ===== MESSAGE EXPIRY TESTS =====
+
+class ExpiryRecorder {
+public:
+    std::vector<int> dispatched;
+    std::vector<std::string> expired;
+
+    void onWork(int value) {
+        dispatched.push_back(value);
+    }
+
+    void onExpired(std::string msgName) {
+        expired.push_back(msgName);
+    }
+};
+
+void testMessageExpiry_ExpiredMessagesDiscardedAndCounted() {
+    testFramework.startTest("MessageExpiry_ExpiredMessages_DiscardedAndCountedPerName");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("ExpiryService", error);
+        ExpiryRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &ExpiryRecorder::onWork);
+        chirp.registerMsgHandler("Report", &recorder, &ExpiryRecorder::onWork);
+        chirp.registerMsgHandler(IChirp::ExpiredMessage, &recorder, &ExpiryRecorder::onExpired);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        auto start = ChirpClock::now();
+        chirp.postMsgWithTtl(std::chrono::milliseconds(10), "Work", 1);
+        chirp.postMsg("Work", 2);
+        chirp.postMsgWithTtl(std::chrono::seconds(1), "Work", 3);
+        chirp.postMsgWithExpiry(start + std::chrono::milliseconds(5), "Report", 4);
+        chirp.postMsgWithExpiry(start + std::chrono::milliseconds(50), "Report", 5);
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   chirp.postMsgWithExpiry(std::chrono::steady_clock::time_point{}, "Work", 6),
+                                   "A missing expiry should be rejected");
+        testFramework.assertEquals(ChirpError::HANDLER_NOT_FOUND,
+                                   chirp.postMsgWithTtl(std::chrono::seconds(1), "Unknown", 7),
+                                   "Expiring posts are validated like postMsg()");
+
+        // The service stalls for 20ms before it gets to its queue
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(20));
+        chirp.poll(SIZE_MAX);
+
+        std::vector<int> expectedDispatched = {2, 3, 5};
+        std::vector<std::string> expectedExpired = {"Work", "Report"};
+        testFramework.assertTrue(recorder.dispatched == expectedDispatched,
+                                 "Only messages still within their expiry should run, in order");
+        testFramework.assertTrue(recorder.expired == expectedExpired,
+                                 "The expired handler should be told which messages were dropped");
+
+        std::map<std::string, uint64_t> counts;
+        chirp.getExpiredMsgCounts(counts);
+        testFramework.assertEquals(2, static_cast<int>(counts.size()), "Counts should be kept per message name");
+        testFramework.assertEquals(1, static_cast<int>(counts["Work"]), "One Work message expired");
+        testFramework.assertEquals(1, static_cast<int>(counts["Report"]), "One Report message expired");
+
+        ChirpServiceStats stats;
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(2, static_cast<int>(stats.messagesExpired), "Service stats should total expiries");
+
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+class DeferredRecorder {
+public:
+    std::vector<int> dispatched;
+
+    void onWork(int value) {
+        dispatched.push_back(value);
+    }
+};
+
+void testDeferredMessages_DispatchedWhenDueInOrder() {
+    testFramework.startTest("DeferredMessages_PostAfterAndPostAt_DispatchedWhenDueInOrder");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("DeferredService", error);
+        DeferredRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &DeferredRecorder::onWork);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        auto start = ChirpClock::now();
+        chirp.postMsgAfter(std::chrono::milliseconds(30), "Work", 30);
+        chirp.postMsgAfter(std::chrono::milliseconds(10), "Work", 10);
+        chirp.postMsgAt(start + std::chrono::milliseconds(20), "Work", 20);
+        chirp.postMsgAt(start + std::chrono::milliseconds(10), "Work", 11);
+        chirp.postMsg("Work", 0);
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   chirp.postMsgAt(std::chrono::steady_clock::time_point{}, "Work", 1),
+                                   "A missing due time should be rejected");
+        testFramework.assertEquals(ChirpError::HANDLER_NOT_FOUND,
+                                   chirp.postMsgAfter(std::chrono::milliseconds(1), "Unknown", 1),
+                                   "Deferred posts are validated like postMsg()");
+
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == std::vector<int>{0},
+                                 "Only the regular post should run before any delay has passed");
+
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(9));
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == std::vector<int>{0},
+                                 "No deferred message should run before it is due");
+
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(15));
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == (std::vector<int>{0, 10, 11}),
+                                 "Messages due at the same time should run in posting order");
+
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(40));
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == (std::vector<int>{0, 10, 11, 20, 30}),
+                                 "Later messages should run once due, in due order");
+
+        // Undelivered deferred messages are freed on shutdown
+        chirp.postMsgAfter(std::chrono::seconds(1), "Work", 99);
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testEdfScheduling_EarliestDeadlineDispatchedFirst() {
+    testFramework.startTest("EdfScheduling_MixedDeadlines_EarliestFirstWithFifoTies");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("EdfService", error);
+        DeferredRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &DeferredRecorder::onWork);
+        chirp.start(IChirp::RunMode::POLLED);
+        testFramework.assertTrue(chirp.getSchedulingPolicy() == IChirp::SchedulingPolicy::FIFO,
+                                 "Services should schedule FIFO by default");
+
+        // Queued under FIFO first: deadlines do not reorder anything yet
+        auto start = ChirpClock::now();
+        chirp.postMsgWithDeadline(start + std::chrono::milliseconds(50), "Work", 50);
+        chirp.postMsg("Work", 0);
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   chirp.postMsgWithDeadline(std::chrono::steady_clock::time_point{}, "Work", 1),
+                                   "A missing deadline should be rejected");
+
+        // Switching reorders the queue; the plain message is due at its post time
+        chirp.setSchedulingPolicy(IChirp::SchedulingPolicy::EARLIEST_DEADLINE_FIRST);
+        chirp.postMsgWithDeadline(start + std::chrono::milliseconds(10), "Work", 10);
+        chirp.postMsgWithDeadline(start + std::chrono::milliseconds(10), "Work", 11);
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(20));
+        chirp.postMsg("Work", 20);
+
+        // The service only gets to its queue after the 10ms deadlines have passed
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(30));
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == (std::vector<int>{0, 10, 11, 20, 50}),
+                                 "Messages should run earliest deadline first, posting order on ties");
+
+        ChirpServiceStats stats;
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(3, static_cast<int>(stats.deadlineMessages), "Three messages carried a deadline");
+        testFramework.assertEquals(2, static_cast<int>(stats.deadlineMisses), "Both 10ms deadlines were missed");
+
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testQueueStats_SojournHistogramAndDepth() {
+    testFramework.startTest("QueueStats_QueuedMessages_SojournHistogramAndDepth");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("QueueStatsService", error);
+        DeferredRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &DeferredRecorder::onWork);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        auto start = ChirpClock::now();
+        for (int i = 0; i < 99; ++i) {
+            chirp.postMsg("Work", i);
+        }
+        ChirpQueueStats before;
+        chirp.getQueueStats(before);
+        testFramework.assertEquals(99, static_cast<int>(before.queueDepth), "All posts should be waiting");
+
+        // 99 messages wait 1ms, then one more waits 1s
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(1));
+        chirp.poll(SIZE_MAX);
+        chirp.postMsg("Work", 99);
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(1) + std::chrono::seconds(1));
+        chirp.poll(SIZE_MAX);
+
+        ChirpQueueStats after;
+        chirp.getQueueStats(after);
+        testFramework.assertEquals(100, static_cast<int>(after.dequeued), "Every dispatch should be counted");
+        testFramework.assertEquals(0, static_cast<int>(after.queueDepth), "The queue should be empty");
+
+        auto p50 = after.sojournPercentile(0.5);
+        auto p99 = after.sojournPercentile(0.99);
+        auto p100 = after.sojournPercentile(1.0);
+        testFramework.assertTrue(p50 >= std::chrono::milliseconds(1) && p50 < std::chrono::milliseconds(2),
+                                 "The median should fall in the 1ms bucket");
+        testFramework.assertTrue(p99 == p50, "99 of 100 messages waited 1ms");
+        testFramework.assertTrue(p100 >= std::chrono::seconds(1) && p100 < std::chrono::seconds(2),
+                                 "The slowest message should fall in the 1s bucket");
+        testFramework.assertTrue(after.sojournPercentile(0.99, &before) == p99,
+                                 "An empty earlier snapshot should not change the result");
+
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+// Handler that takes as long as it is told to, in virtual time
+class VirtualWorker {
+public:
+    void onWork(int millis) {
+        ChirpClock::advanceTo(ChirpClock::now() + std::chrono::milliseconds(millis));
+    }
+};
+
+void testSlowHandlers_OnlyHandlersOverThresholdLogged() {
+    testFramework.startTest("SlowHandlers_MixedRunTimes_OnlyHandlersOverThresholdLogged");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("SlowHandlerService", error);
+        VirtualWorker worker;
+        chirp.registerMsgHandler("Work", &worker, &VirtualWorker::onWork);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   chirp.setSlowHandlerThreshold(std::chrono::nanoseconds(-1)),
+                                   "A negative threshold should be rejected");
+
+        // Nothing is logged before a threshold is set
+        chirp.postMsg("Work", 50);
+        chirp.poll(SIZE_MAX);
+
+        chirp.setSlowHandlerThreshold(std::chrono::milliseconds(10));
+        auto start = ChirpClock::now();
+        chirp.postMsg("Work", 5);
+        chirp.postMsg("Work", 20);
+        chirp.postMsg("Work", 1);
+        chirp.poll(SIZE_MAX);
+
+        std::vector<ChirpSlowHandler> log;
+        chirp.getSlowHandlers(log);
+        testFramework.assertEquals(1, static_cast<int>(log.size()), "Only the 20ms handler should be logged");
+        if (log.size() == 1) {
+            testFramework.assertEquals(std::string("Work"), log[0].message, "The entry should name the handler");
+            testFramework.assertTrue(log[0].duration == std::chrono::milliseconds(20), "The entry should carry the run time");
+            testFramework.assertTrue(log[0].started == start + std::chrono::milliseconds(5),
+                                     "The entry should carry the start time");
+        }
+
+        // The log keeps the newest entries only
+        for (size_t i = 0; i < ChirpSlowHandler::LogCapacity + 5; ++i) {
+            chirp.postMsg("Work", 11);
+        }
+        chirp.poll(SIZE_MAX);
+        chirp.getSlowHandlers(log);
+        testFramework.assertEquals(static_cast<int>(ChirpSlowHandler::LogCapacity), static_cast<int>(log.size()),
+                                   "The log should be bounded");
+        testFramework.assertTrue(log.front().duration == std::chrono::milliseconds(11), "The oldest entries should be dropped");
+
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testLoadShedding_RejectNewAndDropStale() {
+    testFramework.startTest("LoadShedding_Policies_RejectNewAndDropStale");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("SheddingService", error);
+        DeferredRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &DeferredRecorder::onWork);
+        chirp.start(IChirp::RunMode::POLLED);
+
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   chirp.setLoadShedding(IChirp::SheddingPolicy::DROP_STALE),
+                                   "DROP_STALE needs a target sojourn time");
+
+        // Posts are refused while rejecting, and accepted again afterwards
+        chirp.setLoadShedding(IChirp::SheddingPolicy::REJECT_NEW);
+        testFramework.assertTrue(chirp.getLoadShedding() == IChirp::SheddingPolicy::REJECT_NEW, "The policy should be reported");
+        testFramework.assertEquals(ChirpError::SERVICE_OVERLOADED, chirp.postMsg("Work", 1), "New posts should be refused");
+        chirp.setLoadShedding(IChirp::SheddingPolicy::NONE);
+        testFramework.assertEquals(ChirpError::SUCCESS, chirp.postMsg("Work", 2), "Posts should be accepted after shedding");
+        chirp.poll(SIZE_MAX);
+
+        // Two messages wait 10ms, one waits 1ms; only the stale ones are dropped
+        auto start = ChirpClock::now();
+        chirp.postMsg("Work", 3);
+        chirp.postMsg("Work", 4);
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(9));
+        chirp.postMsg("Work", 5);
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(10));
+        chirp.setLoadShedding(IChirp::SheddingPolicy::DROP_STALE, std::chrono::milliseconds(5));
+        chirp.poll(SIZE_MAX);
+        testFramework.assertTrue(recorder.dispatched == (std::vector<int>{2, 5}), "Stale messages should be dropped");
+
+        ChirpServiceStats stats;
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(3, static_cast<int>(stats.messagesShed), "Refused and dropped messages should be counted");
+
+        chirp.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testLazyMode_ThreadSpawnedOnDemandAndReleasedWhenIdle() {
+    testFramework.startTest("LazyMode_Activation_ThreadSpawnedOnDemandAndReleasedWhenIdle");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        Chirp chirp("LazyService", error);
+        DeferredRecorder recorder;
+        chirp.registerMsgHandler("Work", &recorder, &DeferredRecorder::onWork);
+        testFramework.assertEquals(ChirpError::SUCCESS, chirp.start(IChirp::RunMode::LAZY), "Lazy start should succeed");
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS, chirp.setIdleTimeout(std::chrono::milliseconds(-1)),
+                                   "A negative idle timeout should be refused");
+
+        ChirpServiceStats stats;
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(0, static_cast<int>(stats.activations), "No thread before the first message");
+
+        // The first message brings the loop up
+        testFramework.assertEquals(ChirpError::SUCCESS, chirp.syncMsg("Work", 1), "A sync post should wake the service");
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(1, static_cast<int>(stats.activations), "The first message should spawn the thread");
+
+        // Idle for longer than the timeout, the thread is released; the next post spawns a new one
+        chirp.setIdleTimeout(std::chrono::milliseconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        chirp.syncMsg("Work", 2);
+        chirp.getServiceStats(stats);
+        testFramework.assertEquals(2, static_cast<int>(stats.activations), "The idle thread should have been released");
+
+        // A delayed message wakes a dormant service too, and keeps it up until due
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        chirp.postMsgAfter(std::chrono::milliseconds(30), "Work", 3);
+        for (int i = 0; i < 100 && recorder.dispatched.size() < 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        chirp.getServiceStats(stats);
+        testFramework.assertTrue(recorder.dispatched == (std::vector<int>{1, 2, 3}), "Every message should be dispatched");
+        testFramework.assertEquals(3, static_cast<int>(stats.activations), "The delayed message should spawn the thread");
+
+        chirp.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
 int main() {
     std::cout << "Starting Chirp Library Tests\n";
     std::cout << "============================\n\n";
@@ -2108,6 +2666,34 @@ int main() {
         testMessageDefaultConstructor();
         testMessageEdgeCases();
 
+        // Polled run mode tests
+        testPolledMode_PollDispatchesOnCallerThread();
+        testPolledMode_PollFdSignalsWork();
+        testPolledMode_PollOnThreadedService_ReturnsInvalidState();
+
+        // File descriptor handler tests
+        testFdHandler_PipeReadiness_DispatchedOnServiceThread();
+        testFdHandler_InvalidDescriptor_ReturnsInvalidArguments();
+
+        // Message expiry tests
+        testMessageExpiry_ExpiredMessagesDiscardedAndCounted();
+
+        // Deferred message tests
+        testDeferredMessages_DispatchedWhenDueInOrder();
+
+        // Scheduling policy tests
+        testEdfScheduling_EarliestDeadlineDispatchedFirst();
+
+        // Queue statistics tests
+        testQueueStats_SojournHistogramAndDepth();
+
+        // Slow handler log tests
+        testSlowHandlers_OnlyHandlersOverThresholdLogged();
+
+        // Load shedding tests
+        testLoadShedding_RejectNewAndDropStale();
+        testLazyMode_ThreadSpawnedOnDemandAndReleasedWhenIdle();
+
     } catch (const std::exception& e) {
         std::cout << "Test execution failed: " << e.what() << std::endl;
     }
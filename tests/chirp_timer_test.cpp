@@ -6,8 +6,11 @@
 
 #include "ichirp_timer.h"
 #include "chirp_timer.h"
+#include "timer_mgr.h"
 #include "chirp_error.h"
 #include "chirp_logger.h"
+#include "chirp_clock.h"
+#include "ichirp.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -18,6 +21,50 @@
 #include <cassert>
 #include <atomic>
 #include <limits>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations while g_countAllocations is set
+static std::atomic<bool> g_countAllocations{false};
+static std::atomic<int> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    if (g_countAllocations) {
+        g_allocations++;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
 
 // Simple test framework without external dependencies
 class SimpleTestFramework {
@@ -907,6 +954,633 @@ void testGetMessage_WhileRunning_StillReturnsValue() {
     }
 }
 
+// ===== One-shot and absolute deadline TESTS =====
+
+// Counts timer deliveries and optionally deletes the timer from its own handler
+class OneShotReceiver {
+public:
+    int fired = 0;
+    IChirpTimer* deleteOnFire = nullptr;
+
+    ChirpError::Error onTimer(const std::string& /*timerMsg*/) {
+        fired++;
+        if (deleteOnFire) {
+            delete deleteOnFire;
+            deleteOnFire = nullptr;
+        }
+        return ChirpError::SUCCESS;
+    }
+};
+
+void testConfigure_OneShotMode_SetsMode() {
+    testFramework.startTest("ChirpTimer_configure_OneShotMode_SetsMode");
+
+    try {
+        ChirpTimer timer;
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   timer.configure(TimerTestData::validMessage, std::chrono::milliseconds(10),
+                                                   IChirpTimer::TimerMode::ONE_SHOT),
+                                   "One-shot configure should succeed");
+        testFramework.assertTrue(timer.getMode() == IChirpTimer::TimerMode::ONE_SHOT, "Mode should be ONE_SHOT");
+
+        timer.configure(TimerTestData::validMessage, std::chrono::milliseconds(10));
+        testFramework.assertTrue(timer.getMode() == IChirpTimer::TimerMode::PERIODIC,
+                                 "Two-argument configure should select PERIODIC");
+
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testConfigureAt_InvalidUsage_ReturnsErrors() {
+    testFramework.startTest("ChirpTimer_configureAt_InvalidUsage_ReturnsErrors");
+
+    try {
+        ChirpTimer timer;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   timer.configureAt(TimerTestData::emptyMessage, deadline),
+                                   "Empty message should be rejected");
+
+        testFramework.assertEquals(ChirpError::SUCCESS, timer.configureAt(TimerTestData::validMessage, deadline),
+                                   "Valid deadline should be accepted");
+        testFramework.assertEquals(ChirpError::SUCCESS, timer.start(), "Absolute timer should start without a duration");
+        testFramework.assertEquals(ChirpError::INVALID_SERVICE_STATE,
+                                   timer.configureAt(TimerTestData::validMessage, deadline),
+                                   "Cannot reconfigure a running timer");
+
+        timer.stop();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testOneShot_FiresOnceAndReleases() {
+    testFramework.startTest("ChirpTimer_OneShot_FiresOnceAndReleases");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("OneShotService", error);
+        OneShotReceiver receiver;
+        service.registerMsgHandler("Timeout", &receiver, &OneShotReceiver::onTimer);
+        service.start(IChirp::RunMode::POLLED);
+
+        ChirpTimer timer;
+        timer.configure("Timeout", std::chrono::milliseconds(10), IChirpTimer::TimerMode::ONE_SHOT);
+        timer.start();
+        service.addChirpTimer(&timer);
+
+        ChirpClock::advanceTo(ChirpClock::now() + std::chrono::milliseconds(10));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(1, receiver.fired, "One-shot timer should fire at its delay");
+        testFramework.assertFalse(timer.isRunning(), "One-shot timer should stop after firing");
+
+        ChirpClock::advanceTo(ChirpClock::now() + std::chrono::seconds(1));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(1, receiver.fired, "One-shot timer should not fire again");
+
+        service.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testConfigureAt_FiresAtDeadline_HandlerMayDeleteTimer() {
+    testFramework.startTest("ChirpTimer_configureAt_FiresAtDeadline_HandlerMayDeleteTimer");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("DeadlineService", error);
+        OneShotReceiver receiver;
+        service.registerMsgHandler("Deadline", &receiver, &OneShotReceiver::onTimer);
+        service.start(IChirp::RunMode::POLLED);
+
+        IChirpTimer* timer = IChirpTimer::createTimer();
+        auto start = ChirpClock::now();
+        timer->configureAt("Deadline", start + std::chrono::milliseconds(50));
+        timer->start();
+        service.addChirpTimer(timer);
+        receiver.deleteOnFire = timer;
+
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(40));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(0, receiver.fired, "Timer should not fire before its deadline");
+
+        ChirpClock::advanceTo(start + std::chrono::milliseconds(50));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(1, receiver.fired, "Timer should fire at its deadline");
+        testFramework.assertTrue(receiver.deleteOnFire == nullptr, "Handler should have deleted the timer");
+
+        ChirpClock::advanceTo(start + std::chrono::seconds(1));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(1, receiver.fired, "Released timer should not be touched again");
+
+        service.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+// ===== Nanosecond resolution and lateness TESTS =====
+
+void testConfigure_Nanoseconds_KeepsFullResolution() {
+    testFramework.startTest("ChirpTimer_configure_Nanoseconds_KeepsFullResolution");
+
+    try {
+        ChirpTimer timer;
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   timer.configure(TimerTestData::validMessage, std::chrono::microseconds(250),
+                                                   IChirpTimer::TimerMode::PERIODIC),
+                                   "Sub-millisecond duration should be accepted");
+        testFramework.assertTrue(timer.getDurationNs() == std::chrono::microseconds(250),
+                                 "Nanosecond getter should return the exact duration");
+        testFramework.assertEquals(0, static_cast<int>(timer.getDuration().count()),
+                                   "Millisecond getter truncates");
+        testFramework.assertEquals(ChirpError::SUCCESS, timer.start(), "Sub-millisecond timer should start");
+
+        timer.stop();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testLatenessStats_RecordsMinAvgP99Max() {
+    testFramework.startTest("ChirpTimer_getLatenessStats_RecordsMinAvgP99Max");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("LatenessService", error);
+        OneShotReceiver receiver;
+        service.registerMsgHandler("Tick", &receiver, &OneShotReceiver::onTimer);
+        service.start(IChirp::RunMode::POLLED);
+
+        ChirpTimer timer;
+        timer.configure("Tick", std::chrono::microseconds(100), IChirpTimer::TimerMode::PERIODIC);
+        timer.start();
+        auto start = ChirpClock::now();
+        service.addChirpTimer(&timer);
+
+        // 99 firings dispatched 10us late, one 90us late
+        for (int i = 0; i < 100; ++i) {
+            auto lateness = (i == 99) ? std::chrono::microseconds(90) : std::chrono::microseconds(10);
+            ChirpClock::advanceTo(start + std::chrono::microseconds(100) * (i + 1) + lateness);
+            service.poll(SIZE_MAX);
+        }
+        testFramework.assertEquals(100, receiver.fired, "Timer should fire once per period");
+
+        TimerLatenessStats stats;
+        timer.getLatenessStats(stats);
+        testFramework.assertEquals(100, static_cast<int>(stats.samples), "Every firing should be recorded");
+        testFramework.assertTrue(stats.min == std::chrono::microseconds(10), "Min should be exact");
+        testFramework.assertTrue(stats.max == std::chrono::microseconds(90), "Max should be exact");
+        testFramework.assertTrue(stats.avg == std::chrono::nanoseconds(10800), "Avg should be exact");
+        testFramework.assertTrue(stats.p99 >= std::chrono::microseconds(10) &&
+                                 stats.p99 <= std::chrono::nanoseconds(11250),
+                                 "P99 should be the 10us bucket, within 1/8");
+
+        timer.resetLatenessStats();
+        timer.getLatenessStats(stats);
+        testFramework.assertEquals(0, static_cast<int>(stats.samples), "Reset should clear the samples");
+
+        timer.stop();
+        service.removeChirpTimer(&timer);
+        service.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+// Typed timer handlers receiving arguments bound at arm time
+class ConnectionTimers {
+public:
+    int fired = 0;
+    uint64_t lastConnection = 0;
+    std::string lastReason;
+    IChirpTimer* deleteOnFire = nullptr;
+
+    void onIdle(uint64_t connectionId, const std::string& reason) {
+        fired++;
+        lastConnection = connectionId;
+        lastReason = reason;
+        if (deleteOnFire) {
+            delete deleteOnFire;
+            deleteOnFire = nullptr;
+        }
+    }
+
+    void onTick(int slot) {
+        fired++;
+        lastConnection = static_cast<uint64_t>(slot);
+    }
+};
+
+void testTypedTimer_DeliversBoundArguments() {
+    testFramework.startTest("ChirpTimer_TypedTimer_DeliversBoundArguments");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("TypedTimerService", error);
+        service.start(IChirp::RunMode::POLLED);
+        ConnectionTimers handlers;
+
+        IChirpTimer* timer = IChirpTimer::createTimer();
+        timer->configure("IdleTimeout", std::chrono::milliseconds(30), IChirpTimer::TimerMode::ONE_SHOT);
+        timer->start();
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   service.addChirpTimer(timer, &handlers, &ConnectionTimers::onIdle,
+                                                         uint64_t{4711}, std::string("idle")),
+                                   "Typed timer should be added");
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   service.addChirpTimer(timer, static_cast<ConnectionTimers*>(nullptr),
+                                                         &ConnectionTimers::onTick, 1),
+                                   "Null object should be rejected");
+
+        // No message handler is registered for "IdleTimeout"
+        handlers.deleteOnFire = timer;
+        ChirpClock::advanceTo(ChirpClock::now() + std::chrono::milliseconds(30));
+        service.poll(SIZE_MAX);
+        testFramework.assertEquals(1, handlers.fired, "Bound handler should fire without a message handler");
+        testFramework.assertTrue(handlers.lastConnection == 4711, "Bound connection id should be delivered");
+        testFramework.assertEquals(std::string("idle"), handlers.lastReason, "Bound reason should be delivered");
+        testFramework.assertTrue(handlers.deleteOnFire == nullptr, "Handler should be able to delete its timer");
+
+        service.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testTypedTimer_FiringDoesNotAllocate() {
+    testFramework.startTest("ChirpTimer_TypedTimer_FiringDoesNotAllocate");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("TypedTimerAllocService", error);
+        service.start(IChirp::RunMode::POLLED);
+        ConnectionTimers handlers;
+
+        ChirpTimer timer;
+        // Longer than the small string buffer, so copying the name would allocate
+        timer.configure("ConnectionKeepAliveTick", std::chrono::milliseconds(1), IChirpTimer::TimerMode::PERIODIC);
+        timer.start();
+        service.addChirpTimer(&timer, &handlers, &ConnectionTimers::onTick, 7);
+
+        // Warm up: the scratch lists allocate on the first batch
+        ChirpClock::advanceTo(ChirpClock::now() + std::chrono::milliseconds(1));
+        service.poll(SIZE_MAX);
+
+        g_allocations = 0;
+        g_countAllocations = true;
+        for (int i = 0; i < 100; ++i) {
+            ChirpClock::advanceTo(ChirpClock::now() + std::chrono::milliseconds(1));
+            service.poll(SIZE_MAX);
+        }
+        g_countAllocations = false;
+
+        testFramework.assertEquals(101, handlers.fired, "Timer should fire once per period");
+        testFramework.assertEquals(7, static_cast<int>(handlers.lastConnection), "Bound slot should be delivered");
+        testFramework.assertEquals(0, g_allocations.load(), "Firing a typed timer should not allocate");
+
+        timer.stop();
+        service.removeChirpTimer(&timer);
+        service.shutdown();
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        g_countAllocations = false;
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testTimerManager_WithoutLoop() {
+    testFramework.startTest("ChirpTimer_TimerManager_WithoutLoop");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        // No loop arms these timers, so the manager works from their own settings
+        ChirpTimer periodic;
+        periodic.configure("StandalonePeriodic", std::chrono::milliseconds(10), IChirpTimer::TimerMode::PERIODIC);
+        periodic.start();
+        ChirpTimer oneShot;
+        oneShot.configure("StandaloneOneShot", std::chrono::milliseconds(10), IChirpTimer::TimerMode::ONE_SHOT);
+        oneShot.start();
+
+        TimerManager mgr;
+        auto armed = ChirpClock::now();
+        mgr.addTimer(&periodic);
+        mgr.addTimer(&oneShot);
+        testFramework.assertEquals(2, static_cast<int>(mgr.getTimerCount()), "Both timers should be scheduled");
+
+        ChirpClock::advanceTo(armed + std::chrono::milliseconds(10));
+        std::vector<ChirpTimer*> elapsed;
+        mgr.getElapsedTimers(elapsed);
+        testFramework.assertEquals(2, static_cast<int>(elapsed.size()), "Both timers should be due");
+        mgr.rescheduleTimers(elapsed);
+
+        std::chrono::steady_clock::time_point next;
+        testFramework.assertEquals(1, static_cast<int>(mgr.getTimerCount()), "The one-shot timer should be released");
+        testFramework.assertFalse(oneShot.isRunning(), "The one-shot timer should have expired");
+        testFramework.assertTrue(mgr.getFiringTime(&periodic, next), "The periodic timer should stay scheduled");
+        testFramework.assertTrue(next == armed + std::chrono::milliseconds(20), "The periodic timer should move on by one period");
+
+        mgr.removeTimer(&periodic);
+        testFramework.assertFalse(mgr.getFiringTime(&periodic, next), "A removed timer should not be scheduled");
+        testFramework.assertEquals(0, static_cast<int>(mgr.getTimerCount()), "The schedule should be empty");
+
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+// Records firings of timers that were already cancelled
+class CancelChecker {
+public:
+    static constexpr int Slots = 2000;
+    std::atomic<bool> cancelled[Slots] = {};
+    std::atomic<int> fired{0};
+    std::atomic<int> firedAfterCancel{0};
+
+    void onFire(int slot) {
+        fired++;
+        if (cancelled[slot]) {
+            firedAfterCancel++;
+        }
+    }
+};
+
+void testTimerCommands_ConcurrentArmAndCancel() {
+    testFramework.startTest("ChirpTimer_TimerCommands_ConcurrentArmAndCancel");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("TimerCommandService", error);
+        service.start();
+        auto checker = std::make_unique<CancelChecker>();
+
+        // Per-request deadlines: every worker arms a fast timer, lets it
+        // race with the loop, cancels it and frees it straight away
+        const int workers = 4;
+        const int perWorker = CancelChecker::Slots / workers;
+        std::vector<std::thread> threads;
+        for (int w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < perWorker; ++i) {
+                    int slot = w * perWorker + i;
+                    ChirpTimer* timer = new ChirpTimer();
+                    timer->configure("Deadline", std::chrono::microseconds(20), IChirpTimer::TimerMode::PERIODIC);
+                    timer->start();
+                    service.addChirpTimer(timer, checker.get(), &CancelChecker::onFire, slot);
+                    if (i % 8 == 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+                    service.removeChirpTimer(timer);
+                    checker->cancelled[slot] = true;
+                    delete timer;
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        // Anything still queued on the loop must not belong to a cancelled timer
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        testFramework.assertTrue(checker->fired > 0, "Some timers should fire before being cancelled");
+        testFramework.assertEquals(0, checker->firedAfterCancel.load(),
+                                   "No timer may fire once removeChirpTimer() has returned");
+
+        service.shutdown();
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testSetSlack_ValidatesAndStores() {
+    testFramework.startTest("ChirpTimer_setSlack_ValidatesAndStores");
+
+    try {
+        ChirpTimer timer;
+        testFramework.assertTrue(timer.getSlack() == std::chrono::nanoseconds(0), "Timers have no slack by default");
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS, timer.setSlack(std::chrono::nanoseconds(-1)),
+                                   "Negative slack should be rejected");
+        testFramework.assertEquals(ChirpError::SUCCESS, timer.setSlack(std::chrono::microseconds(500)),
+                                   "Positive slack should be accepted");
+        testFramework.assertTrue(timer.getSlack() == std::chrono::microseconds(500), "Slack should be stored");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// Runs a 10ms periodic timer through a 55ms stall and reports how often it fired
+static int fireThroughStall(IChirpTimer::MissedTickPolicy policy, ChirpTimer& timer, int& firedAfterStall) {
+
+    ChirpError::Error error = ChirpError::SUCCESS;
+    IChirp service("StallService", error);
+    OneShotReceiver receiver;
+    service.registerMsgHandler("Tick", &receiver, &OneShotReceiver::onTimer);
+    service.start(IChirp::RunMode::POLLED);
+
+    timer.configure("Tick", std::chrono::milliseconds(10), IChirpTimer::TimerMode::PERIODIC);
+    timer.setMissedTickPolicy(policy);
+    timer.start();
+    auto start = ChirpClock::now();
+    service.addChirpTimer(&timer);
+
+    // Ticks were due at 10, 20, 30, 40 and 50ms. Each poll runs one timer
+    // batch, so keep polling until the loop has nothing left to dispatch.
+    ChirpClock::advanceTo(start + std::chrono::milliseconds(55));
+    size_t dispatched = 0;
+    do {
+        service.poll(SIZE_MAX, &dispatched);
+    } while (dispatched > 0);
+    int fired = receiver.fired;
+
+    // The schedule stays aligned: the next tick is at 60ms
+    ChirpClock::advanceTo(start + std::chrono::milliseconds(59));
+    service.poll(SIZE_MAX);
+    ChirpClock::advanceTo(start + std::chrono::milliseconds(60));
+    service.poll(SIZE_MAX);
+    firedAfterStall = receiver.fired - fired;
+
+    timer.stop();
+    service.removeChirpTimer(&timer);
+    service.shutdown();
+    return fired;
+}
+
+void testMissedTickPolicy_CatchUp_FiresEveryTick() {
+    testFramework.startTest("ChirpTimer_MissedTickPolicy_CatchUp_FiresEveryTick");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpTimer timer;
+        testFramework.assertTrue(timer.getMissedTickPolicy() == IChirpTimer::MissedTickPolicy::CATCH_UP,
+                                 "CATCH_UP should be the default");
+
+        int afterStall = 0;
+        int fired = fireThroughStall(IChirpTimer::MissedTickPolicy::CATCH_UP, timer, afterStall);
+        testFramework.assertEquals(5, fired, "Every overdue tick should be dispatched");
+        testFramework.assertEquals(1, afterStall, "Next tick should stay aligned");
+        testFramework.assertEquals(0, static_cast<int>(timer.getMissedTicks()), "No tick should be missed");
+
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testMissedTickPolicy_Skip_DropsOverdueTicks() {
+    testFramework.startTest("ChirpTimer_MissedTickPolicy_Skip_DropsOverdueTicks");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpTimer timer;
+        int afterStall = 0;
+        int fired = fireThroughStall(IChirpTimer::MissedTickPolicy::SKIP, timer, afterStall);
+        testFramework.assertEquals(0, fired, "Overdue ticks should not be dispatched");
+        testFramework.assertEquals(1, afterStall, "Timer should resume at the next aligned tick");
+        testFramework.assertEquals(5, static_cast<int>(timer.getMissedTicks()), "All five ticks should be missed");
+
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testMissedTickPolicy_Coalesce_FiresOnceAndReportsMissed() {
+    testFramework.startTest("ChirpTimer_MissedTickPolicy_Coalesce_FiresOnceAndReportsMissed");
+
+    ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+    try {
+        ChirpTimer timer;
+        int afterStall = 0;
+        int fired = fireThroughStall(IChirpTimer::MissedTickPolicy::COALESCE, timer, afterStall);
+        testFramework.assertEquals(1, fired, "Overdue ticks should be dispatched once");
+        testFramework.assertEquals(1, afterStall, "Timer should resume at the next aligned tick");
+        testFramework.assertEquals(4, static_cast<int>(timer.getMissedTicks()), "Four ticks should be folded");
+        testFramework.assertEquals(0, static_cast<int>(timer.getLastMissedTicks()),
+                                   "An on-time dispatch should fold nothing");
+
+        ChirpClock::useSystemTime();
+        testFramework.endTest(true);
+    } catch (...) {
+        ChirpClock::useSystemTime();
+        testFramework.endTest(false);
+    }
+}
+
+void testSubMillisecondTimer_FiresOnServiceThread() {
+    testFramework.startTest("ChirpTimer_SubMillisecondPeriod_FiresOnServiceThread");
+
+    try {
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp service("FastTimerService", error);
+        OneShotReceiver receiver;
+        service.registerMsgHandler("FastTick", &receiver, &OneShotReceiver::onTimer);
+        service.start();
+
+        ChirpTimer timer;
+        timer.configure("FastTick", std::chrono::microseconds(250), IChirpTimer::TimerMode::PERIODIC);
+        timer.start();
+        service.addChirpTimer(&timer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        timer.stop();
+        service.removeChirpTimer(&timer);
+        service.shutdown();
+
+        // 400 periods elapsed; leave generous room for loaded machines
+        TimerLatenessStats stats;
+        timer.getLatenessStats(stats);
+        testFramework.assertTrue(stats.samples >= 100, "A 250us timer should fire well over 100 times in 100ms");
+        testFramework.assertTrue(stats.samples == static_cast<uint64_t>(receiver.fired),
+                                 "Every dispatch should be recorded");
+
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testSharedTimerThread_WakesOnlyOwningService() {
+    testFramework.startTest("ChirpTimer_SharedTimerThread_WakesOnlyOwningService");
+
+    try {
+        testFramework.assertEquals(ChirpError::SUCCESS, IChirp::useSharedTimerThread(true),
+                                   "The shared timer thread should start");
+
+        ChirpError::Error error = ChirpError::SUCCESS;
+        IChirp busy("SharedTimerBusy", error);
+        OneShotReceiver receiver;
+        busy.registerMsgHandler("SharedTick", &receiver, &OneShotReceiver::onTimer);
+        busy.start();
+
+        std::vector<std::unique_ptr<IChirp>> idle;
+        for (int i = 0; i < 16; ++i) {
+            idle.push_back(std::make_unique<IChirp>("SharedTimerIdle" + std::to_string(i), error));
+            idle.back()->start();
+        }
+
+        ChirpTimer timer;
+        timer.configure("SharedTick", std::chrono::milliseconds(5), IChirpTimer::TimerMode::PERIODIC);
+        timer.start();
+        busy.addChirpTimer(&timer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        testFramework.assertEquals(ChirpError::INVALID_SERVICE_STATE, IChirp::useSharedTimerThread(false),
+                                   "The shared thread must keep running while services rely on it");
+
+        timer.stop();
+        busy.removeChirpTimer(&timer);
+        testFramework.assertTrue(receiver.fired >= 10, "A 5ms timer should fire through the shared thread");
+
+        uint64_t idleWakeups = 0;
+        for (auto& service : idle) {
+            ChirpServiceStats stats;
+            service->getServiceStats(stats);
+            idleWakeups += stats.wakeups;
+            service->shutdown();
+        }
+        testFramework.assertEquals(0, static_cast<int>(idleWakeups), "Services without due timers should stay parked");
+
+        busy.shutdown();
+        testFramework.assertEquals(ChirpError::SUCCESS, IChirp::useSharedTimerThread(false),
+                                   "The shared thread should stop once no service uses it");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
 // ===== Main Test Runner =====
 
 int main() {
@@ -975,6 +1649,36 @@ int main() {
     testValidateConfiguration_ThroughStart_WhenInvalidDuration();
     testGetDuration_WhileRunning_StillReturnsValue();
     testGetMessage_WhileRunning_StillReturnsValue();
+
+    // One-shot and absolute deadline tests
+    testConfigure_OneShotMode_SetsMode();
+    testConfigureAt_InvalidUsage_ReturnsErrors();
+    testOneShot_FiresOnceAndReleases();
+    testConfigureAt_FiresAtDeadline_HandlerMayDeleteTimer();
+
+    // Nanosecond resolution and lateness tests
+    testConfigure_Nanoseconds_KeepsFullResolution();
+    testLatenessStats_RecordsMinAvgP99Max();
+    testSubMillisecondTimer_FiresOnServiceThread();
+
+    // Shared timer thread tests
+    testSharedTimerThread_WakesOnlyOwningService();
+
+    // Missed-tick policy tests
+    testMissedTickPolicy_CatchUp_FiresEveryTick();
+    testMissedTickPolicy_Skip_DropsOverdueTicks();
+    testMissedTickPolicy_Coalesce_FiresOnceAndReportsMissed();
+
+    // Slack tests
+    testSetSlack_ValidatesAndStores();
+
+    // Typed timer tests
+    testTypedTimer_DeliversBoundArguments();
+    testTypedTimer_FiringDoesNotAllocate();
+    testTimerManager_WithoutLoop();
+
+    // Cross-thread timer command tests
+    testTimerCommands_ConcurrentArmAndCancel();
     
     testFramework.printSummary();
     return testFramework.getFailedTests() > 0 ? 1 : 0;
@@ -22,6 +22,8 @@
 #include <atomic>
 #include <limits>
 #include <map>
+#include <mutex>
+#include <algorithm>
 
 // Simple test framework without external dependencies
 class SimpleTestFramework {
@@ -978,6 +980,274 @@ void testConfigure_Reconfiguration_ReinstallsTimers() {
     }
 }
 
+// ===== Queue Health Tests =====
+
+class SlowWorker {
+public:
+    void onWork(int /*value*/) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+};
+
+class DegradedRecorder {
+public:
+    std::mutex mtx;
+    std::vector<std::string> degraded;
+
+    void onDegraded(std::string serviceName) {
+        std::lock_guard<std::mutex> lock(mtx);
+        degraded.push_back(serviceName);
+    }
+
+    bool reported(const std::string& serviceName) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return std::find(degraded.begin(), degraded.end(), serviceName) != degraded.end();
+    }
+};
+
+void testHealthThresholds_OverloadedService_ReportedDegraded() {
+    testFramework.startTest("ChirpWatchDog_healthThresholds_OverloadedService_ReportedDegraded");
+
+    try {
+        ChirpWatchDog watchdog(WatchdogTestData::validWatchdogName);
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        DegradedRecorder recorder;
+        watchdog.getChirpService()->registerMsgHandler(IChirpWatchDog::DegradedMessage,
+                                                       &recorder, &DegradedRecorder::onDegraded);
+
+        IChirp* slow = nullptr;
+        IChirp* idle = nullptr;
+        factory.createService("HealthSlowService", &slow);
+        factory.createService("HealthIdleService", &idle);
+        SlowWorker worker;
+        slow->registerMsgHandler("Work", &worker, &SlowWorker::onWork);
+        slow->start();
+        idle->start();
+
+        testFramework.assertEquals(ChirpError::INVALID_ARGUMENTS,
+                                   watchdog.setHealthThresholds("", std::chrono::milliseconds(1), 10),
+                                   "A service name is required");
+        watchdog.setHealthThresholds("HealthSlowService", std::chrono::milliseconds(1), 20);
+        watchdog.setHealthThresholds("HealthIdleService", std::chrono::milliseconds(1), 20);
+        watchdog.configure(&factory, std::chrono::milliseconds(20));
+        watchdog.start();
+
+        // The service keeps making progress, but each message now waits far longer than 1ms
+        for (int i = 0; i < 100; ++i) {
+            slow->postMsg("Work", i);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+        ChirpQueueStats stats;
+        slow->getQueueStats(stats);
+        testFramework.assertTrue(stats.dequeued > 0, "The slow service should still make progress");
+        testFramework.assertTrue(recorder.reported("HealthSlowService"), "The backlogged service should be reported degraded");
+        testFramework.assertTrue(!recorder.reported("HealthIdleService"), "An idle service should not be reported");
+
+        watchdog.stop();
+        factory.destroyService("HealthSlowService");
+        factory.destroyService("HealthIdleService");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testLoadShedding_AppliedWhenDegradedLiftedAfterRecovery() {
+    testFramework.startTest("ChirpWatchDog_loadShedding_AppliedWhenDegradedLiftedAfterRecovery");
+
+    try {
+        ChirpWatchDog watchdog(WatchdogTestData::validWatchdogName);
+        IChirpFactory& factory = IChirpFactory::getInstance();
+
+        IChirp* busy = nullptr;
+        factory.createService("SheddingBusyService", &busy);
+        SlowWorker worker;
+        busy->registerMsgHandler("Work", &worker, &SlowWorker::onWork);
+        busy->start();
+
+        watchdog.setHealthThresholds("SheddingBusyService", std::chrono::milliseconds(1), 20);
+        watchdog.setLoadShedding("SheddingBusyService", IChirp::SheddingPolicy::REJECT_NEW);
+        watchdog.configure(&factory, std::chrono::milliseconds(20));
+        watchdog.start();
+
+        for (int i = 0; i < 100; ++i) {
+            busy->postMsg("Work", i);
+        }
+        bool shedding = false;
+        for (int i = 0; i < 500 && !shedding; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            shedding = busy->getLoadShedding() == IChirp::SheddingPolicy::REJECT_NEW;
+        }
+        testFramework.assertTrue(shedding, "The overloaded service should start shedding");
+        testFramework.assertEquals(ChirpError::SERVICE_OVERLOADED, busy->postMsg("Work", 100),
+                                   "New posts should be refused while shedding");
+
+        // The backlog drains, then the service must stay healthy for a while before shedding stops
+        bool lifted = false;
+        for (int i = 0; i < 2000 && !lifted; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            lifted = busy->getLoadShedding() == IChirp::SheddingPolicy::NONE;
+        }
+        ChirpQueueStats stats;
+        busy->getQueueStats(stats);
+        testFramework.assertTrue(lifted, "Shedding should be lifted after recovery");
+        testFramework.assertEquals(0, static_cast<int>(stats.queueDepth), "Shedding should outlast the backlog");
+        testFramework.assertEquals(ChirpError::SUCCESS, busy->postMsg("Work", 101), "Posts should be accepted again");
+
+        watchdog.stop();
+        factory.destroyService("SheddingBusyService");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testLoadShedding_DropStaleNeedsSojournThreshold() {
+    testFramework.startTest("ChirpWatchDog_loadShedding_DropStaleNeedsSojournThreshold");
+
+    try {
+        ChirpWatchDog watchdog("SheddingConfigWatchdog");
+
+        // Depth-only thresholds leave DROP_STALE without a target
+        watchdog.setHealthThresholds("DepthOnlyService", std::chrono::nanoseconds(0), 20);
+        testFramework.assertEquals(ChirpError::INVALID_CONFIGURATION,
+                                   watchdog.setLoadShedding("DepthOnlyService", IChirp::SheddingPolicy::DROP_STALE),
+                                   "DROP_STALE should be refused without a sojourn threshold");
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   watchdog.setLoadShedding("DepthOnlyService", IChirp::SheddingPolicy::REJECT_NEW),
+                                   "REJECT_NEW needs no sojourn threshold");
+
+        // The same check the other way round
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   watchdog.setLoadShedding("StaleService", IChirp::SheddingPolicy::DROP_STALE),
+                                   "DROP_STALE may be set before the thresholds");
+        testFramework.assertEquals(ChirpError::INVALID_CONFIGURATION,
+                                   watchdog.setHealthThresholds("StaleService", std::chrono::nanoseconds(0), 20),
+                                   "A depth-only threshold should be refused under DROP_STALE");
+        testFramework.assertEquals(ChirpError::SUCCESS,
+                                   watchdog.setHealthThresholds("StaleService", std::chrono::milliseconds(1), 20),
+                                   "A sojourn threshold gives DROP_STALE its target");
+
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+// ===== Heartbeat Tests =====
+
+class StuckWorker {
+public:
+    void onWork(int millis) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+    }
+};
+
+class StuckRecorder {
+public:
+    std::mutex mtx;
+    std::string service;
+    std::string handler;
+    std::chrono::nanoseconds running{0};
+
+    void onStuck(std::string serviceName, std::string handlerName, std::chrono::nanoseconds runningFor) {
+        std::lock_guard<std::mutex> lock(mtx);
+        service = serviceName;
+        handler = handlerName;
+        running = runningFor;
+    }
+};
+
+void testHeartbeat_StuckHandler_ReportedIdleServiceNot() {
+    testFramework.startTest("ChirpWatchDog_heartbeat_StuckHandler_ReportedIdleServiceNot");
+
+    try {
+        ChirpWatchDog watchdog(WatchdogTestData::validWatchdogName);
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        DegradedRecorder recorder;
+        watchdog.getChirpService()->registerMsgHandler(IChirpWatchDog::MissedPetMessage,
+                                                       &recorder, &DegradedRecorder::onDegraded);
+        StuckRecorder culprit;
+        watchdog.getChirpService()->registerMsgHandler(IChirpWatchDog::StuckHandlerMessage,
+                                                       &culprit, &StuckRecorder::onStuck);
+
+        IChirp* stuck = nullptr;
+        IChirp* idle = nullptr;
+        factory.createService("HeartbeatStuckService", &stuck);
+        factory.createService("HeartbeatIdleService", &idle);
+        StuckWorker worker;
+        stuck->registerMsgHandler("Work", &worker, &StuckWorker::onWork);
+        stuck->setWatchDogMonitoring(true);
+        idle->setWatchDogMonitoring(true);
+        stuck->start();
+        idle->start();
+
+        watchdog.configure(&factory, std::chrono::milliseconds(10));
+        watchdog.start();
+
+        // One handler that blocks the loop far longer than the 21ms threshold,
+        // while the other service waits for work the whole time
+        stuck->postMsg("Work", 200);
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+        testFramework.assertTrue(recorder.reported("HeartbeatStuckService"), "The stuck service should miss its pet");
+        {
+            std::lock_guard<std::mutex> lock(culprit.mtx);
+            testFramework.assertEquals(std::string("HeartbeatStuckService"), culprit.service, "The stuck service should be named");
+            testFramework.assertEquals(std::string("Work"), culprit.handler, "The culprit handler should be named");
+            testFramework.assertTrue(culprit.running > std::chrono::milliseconds(21), "The handler's run time should be reported");
+        }
+        testFramework.assertTrue(!recorder.reported("HeartbeatIdleService"), "A service waiting for work should not miss its pet");
+
+        watchdog.stop();
+        factory.destroyService("HeartbeatStuckService");
+        factory.destroyService("HeartbeatIdleService");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
+void testRegistry_ServiceCreatedAfterConfigure_IsMonitored() {
+    testFramework.startTest("ChirpWatchDog_registry_ServiceCreatedAfterConfigure_IsMonitored");
+
+    try {
+        ChirpWatchDog watchdog(WatchdogTestData::validWatchdogName);
+        IChirpFactory& factory = IChirpFactory::getInstance();
+        DegradedRecorder recorder;
+        watchdog.getChirpService()->registerMsgHandler(IChirpWatchDog::MissedPetMessage,
+                                                       &recorder, &DegradedRecorder::onDegraded);
+        watchdog.configure(&factory, std::chrono::milliseconds(10));
+        watchdog.start();
+
+        // Neither exists when the watchdog is configured
+        IChirp* late = nullptr;
+        IChirp* gone = nullptr;
+        factory.createService("RegistryLateService", &late);
+        factory.createService("RegistryGoneService", &gone);
+        StuckWorker worker;
+        late->registerMsgHandler("Work", &worker, &StuckWorker::onWork);
+        late->setWatchDogMonitoring(true);
+        gone->setWatchDogMonitoring(true);
+        late->start();
+        gone->start();
+        factory.destroyService("RegistryGoneService");
+
+        late->postMsg("Work", 200);
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+        testFramework.assertTrue(recorder.reported("RegistryLateService"), "A service created after configure should be monitored");
+        testFramework.assertTrue(!recorder.reported("RegistryGoneService"), "A destroyed service should not be reported");
+
+        watchdog.stop();
+        factory.destroyService("RegistryLateService");
+        testFramework.endTest(true);
+    } catch (...) {
+        testFramework.endTest(false);
+    }
+}
+
 // ===== Main Test Runner =====
 
 int main() {
@@ -1032,6 +1302,15 @@ int main() {
     testUninstallPetTimers_WhenFactoryNull_HandlesGracefully();
     testInstallMonitorTimer_WhenChirpServiceNull_ReturnsEarly();
     testConfigure_Reconfiguration_ReinstallsTimers();
+
+    // Queue health tests
+    testHealthThresholds_OverloadedService_ReportedDegraded();
+    testLoadShedding_AppliedWhenDegradedLiftedAfterRecovery();
+    testLoadShedding_DropStaleNeedsSojournThreshold();
+
+    // Heartbeat tests
+    testHeartbeat_StuckHandler_ReportedIdleServiceNot();
+    testRegistry_ServiceCreatedAfterConfigure_IsMonitored();
     
     testFramework.printSummary();
     return testFramework.getFailedTests() > 0 ? 1 : 0;
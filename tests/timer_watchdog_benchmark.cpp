@@ -10,6 +10,8 @@
 #include "ichirp_factory.h"
 #include "ichirp.h"
 #include "chirp_error.h"
+#include "chirp_clock.h"
+#include "timer_mgr.h"
 #include <iostream>
 #include <chrono>
 #include <vector>
@@ -486,6 +488,84 @@ void benchmarkMemoryUsage() {
     suite.printResults();
 }
 
+void benchmarkTimerManagerScaling() {
+    std::cout << "Running TimerManager Scaling Benchmarks...\n";
+    std::cout << "(ns per operation; should stay roughly flat as the timer count grows)\n\n";
+    std::cout << std::setw(10) << "timers"
+              << std::setw(12) << "add"
+              << std::setw(12) << "idle iter"
+              << std::setw(12) << "cancel+add"
+              << std::setw(12) << "expiry" << "\n";
+
+    std::mt19937 rng(42);
+    const size_t ops = 10000;
+
+    for (size_t count : {10ul, 100ul, 1000ul, 10000ul, 100000ul, 1000000ul}) {
+        // Virtual time lets the expiry pass jump from deadline to deadline
+        ChirpClock::useVirtualTime(std::chrono::steady_clock::now());
+
+        std::vector<std::unique_ptr<ChirpTimer>> timers;
+        timers.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto duration = std::chrono::milliseconds(1000 + rng() % 3600000);
+            timers.push_back(std::make_unique<ChirpTimer>("T", duration));
+            timers.back()->start();
+        }
+
+        TimerManager mgr;
+        auto perOp = [](std::chrono::steady_clock::duration d, size_t n) {
+            return std::chrono::duration<double, std::nano>(d).count() / static_cast<double>(n);
+        };
+
+        // Insert every timer
+        auto start = std::chrono::steady_clock::now();
+        for (auto& timer : timers) {
+            mgr.addTimer(timer.get());
+        }
+        double addNs = perOp(std::chrono::steady_clock::now() - start, count);
+
+        // Loop iteration with nothing due: look for elapsed timers and the next deadline
+        std::vector<ChirpTimer*> elapsed;
+        std::chrono::steady_clock::time_point next;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ops; ++i) {
+            mgr.getElapsedTimers(elapsed);
+            mgr.getNextTimerFiringTime(next);
+        }
+        double idleNs = perOp(std::chrono::steady_clock::now() - start, ops);
+
+        // Connection churn: cancel a random timer and arm it again
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ops; ++i) {
+            ChirpTimer* timer = timers[rng() % count].get();
+            mgr.removeTimer(timer);
+            mgr.addTimer(timer);
+        }
+        double churnNs = perOp(std::chrono::steady_clock::now() - start, ops);
+
+        // Expiry: jump to each deadline and fire/reschedule what is due
+        size_t fired = 0;
+        start = std::chrono::steady_clock::now();
+        while (fired < ops && mgr.getNextTimerFiringTime(next)) {
+            ChirpClock::advanceTo(next);
+            mgr.getElapsedTimers(elapsed);
+            mgr.rescheduleTimers(elapsed);
+            fired += elapsed.size();
+        }
+        double expiryNs = perOp(std::chrono::steady_clock::now() - start, std::max<size_t>(fired, 1));
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(10) << count
+                  << std::setw(12) << addNs
+                  << std::setw(12) << idleNs
+                  << std::setw(12) << churnNs
+                  << std::setw(12) << expiryNs << "\n";
+    }
+
+    ChirpClock::useSystemTime();
+    std::cout << "\n";
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "=== Timer and Watchdog Benchmark Suite ===\n\n";
     
@@ -511,12 +591,15 @@ int main(int argc, char* argv[]) {
             benchmarkWatchdogMonitoring();
         } else if (benchmark == "memory") {
             benchmarkMemoryUsage();
+        } else if (benchmark == "timer-scaling") {
+            benchmarkTimerManagerScaling();
         } else {
             std::cout << "Unknown benchmark: " << benchmark << "\n";
             std::cout << "Available benchmarks:\n";
             std::cout << "  timer-creation, timer-ops, timer-reconfig\n";
             std::cout << "  watchdog-creation, watchdog-config, watchdog-lifecycle\n";
             std::cout << "  concurrent, state-queries, monitoring, memory\n";
+            std::cout << "  timer-scaling\n";
             return 1;
         }
     } else {
@@ -531,6 +614,7 @@ int main(int argc, char* argv[]) {
         benchmarkTimerStateQueries();
         benchmarkWatchdogMonitoring();
         benchmarkMemoryUsage();
+        benchmarkTimerManagerScaling();
     }
     
     return 0;